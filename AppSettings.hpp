@@ -5,6 +5,10 @@ public:
     static int canvasWidth;
     static int canvasHeight;
 
+    // LoX1ӂ̃^C͈̔́iN_CAOEvWFNgǂݍ݂ŋʁj
+    static constexpr int MIN_CANVAS_TILES = 50;
+    static constexpr int MAX_CANVAS_TILES = 4096;
+
     // ݒXV
     static void updateSettings(int newTileSize, int newCanvasWidth, int newCanvasHeight) {
         tileSize = newTileSize;
@@ -0,0 +1,343 @@
+﻿#include "Benchmark.hpp"
+#include "Canvas.hpp"
+#include "SoftwareRasterizer.hpp"
+#include "SaveLoad.hpp"
+#include "DrawingTools.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <chrono>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <filesystem>
+
+namespace {
+    const int REPEAT_COUNT = 3; // 各条件の試行回数（最速値を採用）
+
+    // 出力バッファの比較用ハッシュ（FNV-1a、バンドごとに続きから計算できる）
+    const uint64_t HASH_SEED = 1469598103934665603ull;
+
+    uint64_t hashPixels(uint64_t hash, const sf::Uint8* pixels, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            hash ^= pixels[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // 計測するスレッド数：1, 2, 4, ... と最大値
+    std::vector<unsigned> getThreadCounts(unsigned maxThreads) {
+        std::vector<unsigned> counts;
+        for (unsigned count = 1; count < maxThreads; count *= 2) {
+            counts.push_back(count);
+        }
+        counts.push_back(maxThreads);
+        return counts;
+    }
+
+    const int SCALING_SIZES[] = { 512, 1024, 2048, 4096 };
+    const int ISLAND_STEP = 256;  // 塗り領域の配置間隔（タイル）
+    const int ISLAND_SIZE = 128;  // 塗り領域1辺のタイル数（全体の1/4を塗る）
+    // ツール計測：画面1枚分の表示範囲に、ブラシのストロークを引いて変更矩形を再描画する
+    const int VIEW_WIDTH_PIXELS = 1920;
+    const int VIEW_HEIGHT_PIXELS = 1080;
+    const int STROKE_COUNT = 16;
+    const int STROKE_BRUSH_SIZE = 8;
+    const char* const SCALING_TEMP_FILE = "dotarp_canvas_scaling_benchmark.tmp"; // 一時ディレクトリに作成
+    const std::size_t EXPORT_BAND_BYTES = 32 * 1024 * 1024; // PNGストリーミング出力と同じバンド上限
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    double toMegaBytes(std::size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    // ストローク処理（DrawingTool の保護メンバー）をツールと同じ経路で呼ぶための派生クラス
+    class BenchmarkBrush : public BrushTool {
+    public:
+        using DrawingTool::stampBrushLine;
+    };
+
+    // 計測の入力（開始時に複製するため、計測中にキャンバスを編集・再作成しても影響を受けない）
+    struct BenchmarkInput {
+        TileGrid tiles;                        // コピーオンライトのスナップショット（複製はO(1)）
+        int tileSize = 1;
+        PatternAtlas::Settings atlasSettings;  // 画像出力と同じ設定（グリッド線なし、spacing 0、shrink 1）
+        PaletteSnapshot palette;
+    };
+
+    // バックグラウンド実行の状態（同時に実行する計測は1つだけ）
+    std::thread worker;
+    std::atomic<bool> running(false);
+    std::atomic<bool> cancelRequested(false);
+
+    bool reportCancelled() {
+        if (!cancelRequested) return false;
+        std::cout << "  (benchmark cancelled)" << std::endl;
+        return true;
+    }
+
+    // 一時ファイルのパス（一時ディレクトリが取得できない場合は空）
+    std::filesystem::path getScalingTempPath() {
+        std::error_code error;
+        std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+        if (error) return std::filesystem::path();
+        return directory / SCALING_TEMP_FILE;
+    }
+
+    // 1バンドのタイル行数（PNGストリーミング出力と同じく EXPORT_BAND_BYTES 以内）
+    int getBandTileRows(int widthTiles, int heightTiles, int tileSize) {
+        const std::size_t tileRowBytes = static_cast<std::size_t>(widthTiles) * tileSize * tileSize * 4;
+        return static_cast<int>(std::max<std::size_t>(1,
+            std::min<std::size_t>(heightTiles, EXPORT_BAND_BYTES / tileRowBytes)));
+    }
+
+    void exportScaling(const BenchmarkInput& input) {
+
+        const TileGrid& tiles = input.tiles;
+        const int tileSize = input.tileSize;
+        const int width = tiles.getWidth();
+        const int height = tiles.getHeight();
+        const double megaPixels = static_cast<double>(width) * tileSize * height * tileSize / 1000000.0;
+
+        SoftwareRasterizer rasterizer(input.atlasSettings, false, sf::Color::Transparent);
+        rasterizer.prepare(input.palette.cells, input.palette.colors);
+
+        // PNG出力と同じくタイル行のバンドごとに描画する（画像全体のバッファは確保しない）
+        const std::size_t tileRowBytes = static_cast<std::size_t>(width) * tileSize * tileSize * 4;
+        const int bandTileRows = getBandTileRows(width, height, tileSize);
+        std::vector<sf::Uint8> band(tileRowBytes * bandTileRows);
+
+        // 書式はstd::coutに設定せず行ごとに組み立てる（UIスレッドの出力に影響させない）
+        std::ostringstream header;
+        header << "=== Export rasterization benchmark ===\n"
+            << "Canvas: " << width << "x" << height << " tiles, "
+            << tileSize << " px/tile (" << std::fixed << std::setprecision(1) << megaPixels << " MP, "
+            << bandTileRows << " tile rows per band)";
+        std::cout << header.str() << std::endl;
+
+        double baseSeconds = 0.0;
+        uint64_t baseHash = 0;
+        for (unsigned threads : getThreadCounts(SoftwareRasterizer::getDefaultThreadCount())) {
+            double bestSeconds = 0.0;
+            uint64_t hash = HASH_SEED;
+            for (int i = 0; i < REPEAT_COUNT; ++i) {
+                // 描画時間のみを合計し、ハッシュは初回の各バンドから続けて計算する
+                double seconds = 0.0;
+                for (int row = 0; row < height; row += bandTileRows) {
+                    if (reportCancelled()) return;
+                    const int rowEnd = std::min(height, row + bandTileRows);
+                    auto start = std::chrono::steady_clock::now();
+                    rasterizer.renderTileRowsParallel(tiles, row, rowEnd, band.data(), threads);
+                    seconds += secondsSince(start);
+                    if (i == 0) {
+                        hash = hashPixels(hash, band.data(), tileRowBytes * (rowEnd - row));
+                    }
+                }
+                if (i == 0 || seconds < bestSeconds) {
+                    bestSeconds = seconds;
+                }
+            }
+
+            if (threads == 1) {
+                baseSeconds = bestSeconds;
+                baseHash = hash;
+            }
+
+            std::ostringstream line;
+            line << std::fixed << "  threads " << std::setw(2) << threads << ": "
+                << std::setprecision(1) << std::setw(8) << bestSeconds * 1000.0 << " ms, "
+                << std::setw(7) << megaPixels / bestSeconds << " MP/s, speedup x"
+                << std::setprecision(2) << baseSeconds / bestSeconds
+                << (hash == baseHash ? "  (identical)" : "  (MISMATCH)");
+            std::cout << line.str() << std::endl;
+        }
+    }
+
+    void canvasScaling(const BenchmarkInput& input) {
+
+        // チャンクテクスチャの描画にはこのスレッド用のOpenGLコンテキストが必要
+        sf::Context context;
+
+        const PaletteSnapshot& palette = input.palette;
+        const int tileSize = input.tileSize;
+        const int patternCount = std::max(1, palette.getPatternCount());
+        const std::filesystem::path tempPath = getScalingTempPath();
+
+        SoftwareRasterizer rasterizer(input.atlasSettings, false, sf::Color::Transparent);
+        rasterizer.prepare(palette.cells, palette.colors);
+
+        std::ostringstream header;
+        header << "=== Canvas scaling benchmark ===\n"
+            << tileSize << " px/tile, 1/4 of each canvas painted in "
+            << ISLAND_SIZE << "x" << ISLAND_SIZE << " islands";
+        std::cout << header.str() << std::endl;
+
+        for (int size : SCALING_SIZES) {
+            for (TileGrid::Storage storage : { TileGrid::Storage::Dense, TileGrid::Storage::Sparse }) {
+                if (reportCancelled()) return;
+                const bool sparse = storage == TileGrid::Storage::Sparse;
+
+                // 塗り：島状の領域を行スパンで埋める
+                auto start = std::chrono::steady_clock::now();
+                Canvas scaled(size, size, tileSize, sf::Vector2f(0.0f, 0.0f), storage);
+                for (int y = 0; y < size; ++y) {
+                    if (y % ISLAND_STEP >= ISLAND_SIZE) continue;
+                    for (int x = 0; x < size; x += ISLAND_STEP) {
+                        scaled.fillTileSpan(y, x, x + ISLAND_SIZE, (x / ISLAND_STEP + y / ISLAND_STEP) % patternCount);
+                    }
+                }
+                const double fillSeconds = secondsSince(start);
+                const TileGrid& tiles = scaled.getTiles();
+                const std::size_t memoryBytes = tiles.getMemoryUsage();
+
+                // 表示範囲（左上の画面1枚分）のチャンクキャッシュを生成
+                const sf::FloatRect viewArea(0.0f, 0.0f,
+                    static_cast<float>(std::min(VIEW_WIDTH_PIXELS, size * tileSize)),
+                    static_cast<float>(std::min(VIEW_HEIGHT_PIXELS, size * tileSize)));
+                start = std::chrono::steady_clock::now();
+                scaled.updateChunkCache(palette, viewArea);
+                const double cacheSeconds = secondsSince(start);
+
+                // ツール：表示範囲を横断するストロークをブラシツールと同じ stampBrushLine で書き込む
+                const int viewTilesX = static_cast<int>(viewArea.width) / tileSize;
+                const int viewTilesY = static_cast<int>(viewArea.height) / tileSize;
+                BenchmarkBrush brush;
+                start = std::chrono::steady_clock::now();
+                for (int i = 0; i < STROKE_COUNT; ++i) {
+                    const int y = viewTilesY * i / STROKE_COUNT;
+                    brush.stampBrushLine(sf::Vector2i(0, y), sf::Vector2i(viewTilesX - 1, viewTilesY - 1 - y),
+                        STROKE_BRUSH_SIZE, scaled, i % patternCount);
+                }
+                const double toolSeconds = secondsSince(start);
+
+                // 再描画：ストロークで記録された変更矩形だけをチャンクテクスチャへ反映（GPUへの送信までを計測）
+                start = std::chrono::steady_clock::now();
+                scaled.updateChunkCache(palette, viewArea);
+                const double repaintSeconds = secondsSince(start);
+
+                // 保存・読み込み（プロジェクトファイルと同じキャンバス部の形式、一時ディレクトリに書き出す）
+                start = std::chrono::steady_clock::now();
+                bool saveOk = false;
+                if (!tempPath.empty()) {
+                    std::ofstream ofs(tempPath, std::ios::binary);
+                    if (ofs) {
+                        writeCanvasTiles(ofs, tiles);
+                        ofs.close();
+                        saveOk = !ofs.fail();
+                    }
+                }
+                const double saveSeconds = secondsSince(start);
+
+                double loadSeconds = 0.0;
+                std::streamoff fileBytes = 0;
+                bool loadOk = false;
+                if (saveOk) {
+                    start = std::chrono::steady_clock::now();
+                    TileGrid loaded(size, size, TileGrid::EMPTY, storage);
+                    std::ifstream ifs(tempPath, std::ios::binary | std::ios::ate);
+                    fileBytes = ifs.tellg();
+                    ifs.seekg(0);
+                    loadOk = ifs && readCanvasTiles(ifs, size, size, loaded) && loaded == tiles;
+                    loadSeconds = secondsSince(start);
+                }
+                if (!tempPath.empty()) {
+                    std::error_code error;
+                    std::filesystem::remove(tempPath, error);
+                }
+
+                // 画像出力：PNG出力と同じバンド単位の描画（エンコードは除く）
+                const std::size_t tileRowBytes = static_cast<std::size_t>(size) * tileSize * tileSize * 4;
+                const int bandTileRows = getBandTileRows(size, size, tileSize);
+                std::vector<sf::Uint8> band(tileRowBytes * bandTileRows);
+                start = std::chrono::steady_clock::now();
+                for (int row = 0; row < size; row += bandTileRows) {
+                    if (reportCancelled()) return;
+                    rasterizer.renderTileRowsParallel(tiles, row, std::min(size, row + bandTileRows), band.data());
+                }
+                const double exportSeconds = secondsSince(start);
+                const double megaPixels = static_cast<double>(size) * tileSize * size * tileSize / 1000000.0;
+
+                // 1行分をまとめて出力
+                std::ostringstream line;
+                line << std::fixed << std::setprecision(1)
+                    << "  " << std::setw(4) << size << "x" << std::setw(4) << size
+                    << (sparse ? " sparse" : " dense ")
+                    << " | mem " << std::setw(7) << toMegaBytes(memoryBytes) << " MB"
+                    << " | fill " << std::setw(7) << fillSeconds * 1000.0 << " ms"
+                    << " | cache " << std::setw(6) << cacheSeconds * 1000.0 << " ms"
+                    << " | tool " << std::setw(6) << toolSeconds * 1000.0 << " ms (" << STROKE_COUNT << " strokes)"
+                    << " | repaint " << std::setw(6) << repaintSeconds * 1000.0 << " ms";
+                if (saveOk) {
+                    line << " | save " << std::setw(7) << saveSeconds * 1000.0 << " ms"
+                        << " | load " << std::setw(7) << loadSeconds * 1000.0 << " ms"
+                        << " (" << toMegaBytes(static_cast<std::size_t>(std::max<std::streamoff>(0, fileBytes))) << " MB file"
+                        << (loadOk ? "" : ", MISMATCH") << ")";
+                }
+                else {
+                    line << " | save/load skipped (cannot write "
+                        << (tempPath.empty() ? std::string("temp directory") : tempPath.string()) << ")";
+                }
+                line << " | export " << std::setw(8) << exportSeconds * 1000.0 << " ms, "
+                    << megaPixels / exportSeconds << " MP/s";
+                std::cout << line.str() << std::endl;
+            }
+        }
+    }
+
+    /**
+     * 入力を複製して計測をバックグラウンドのスレッドで開始
+     */
+    bool startInBackground(const Canvas& canvas, const PaletteSnapshot& palette,
+        void (*job)(const BenchmarkInput&)) {
+        if (running) {
+            std::cout << "Benchmark is already running" << std::endl;
+            return false;
+        }
+        if (worker.joinable()) {
+            worker.join();
+        }
+
+        BenchmarkInput input;
+        input.tiles = canvas.getTiles();
+        input.tileSize = canvas.getTileSize();
+        input.atlasSettings = canvas.getAtlasSettings(0.0f, 1.0f);
+        input.palette = palette;
+
+        cancelRequested = false;
+        running = true;
+        worker = std::thread([job, input = std::move(input)]() {
+            try {
+                job(input);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Error: Benchmark failed: " << e.what() << std::endl;
+            }
+            running = false;
+        });
+        return true;
+    }
+}
+
+namespace Benchmark {
+
+    bool startExportScaling(const Canvas& canvas, const PaletteSnapshot& palette) {
+        return startInBackground(canvas, palette, exportScaling);
+    }
+
+    bool startCanvasScaling(const Canvas& canvas, const PaletteSnapshot& palette) {
+        return startInBackground(canvas, palette, canvasScaling);
+    }
+
+    void shutdown() {
+        cancelRequested = true;
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
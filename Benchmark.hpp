@@ -0,0 +1,39 @@
+﻿//===== Benchmark.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <array>
+
+class Canvas;
+struct PaletteSnapshot;
+
+/**
+ * 開発用の計測処理（F9・F10キーで実行、結果はコンソールへ出力）
+ * 計測はバックグラウンドのスレッドで行い、UIは止めない（同時に実行できる計測は1つ）
+ * タイル・パレット・描画設定は開始時に複製するため、計測中もキャンバスを編集できる
+ */
+namespace Benchmark {
+
+    /**
+     * 画像出力のCPU描画をスレッド数 1..N で計測し、速度向上率を表示
+     * PNG出力と同じバンド単位で描画するため、最大サイズのキャンバスでもメモリは1バンド分のみ
+     * 各スレッド数の出力が1スレッドの結果とビット単位で一致するかも確認する（バンドごとに続けてハッシュ）
+     * @return 開始した場合true（他の計測が実行中ならfalse）
+     */
+    bool startExportScaling(const Canvas& canvas, const PaletteSnapshot& palette);
+
+    /**
+     * 512, 1024, 2048, 4096 四方のキャンバスを密格納・疎格納それぞれで生成し、
+     * 塗り・表示範囲のキャッシュ生成・ブラシのストローク・変更矩形の再描画・保存・読み込み・
+     * 画像出力（バンド描画）の時間と使用メモリを表示
+     * タイルサイズ・パレットは現在のキャンバスのものを使用し、現在のキャンバスは変更しない
+     * 保存・読み込みの計測ファイルは一時ディレクトリに作成し、書き込めない場合は計測を省略して理由を表示
+     * @return 開始した場合true（他の計測が実行中ならfalse）
+     */
+    bool startCanvasScaling(const Canvas& canvas, const PaletteSnapshot& palette);
+
+    /**
+     * 実行中の計測に中断を要求し、スレッドの終了を待つ（アプリ終了時に呼ぶ）
+     */
+    void shutdown();
+}
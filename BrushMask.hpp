@@ -0,0 +1,95 @@
+﻿//===== BrushMask.hpp =====
+#pragma once
+#include <array>
+#include <algorithm>
+
+/**
+ * ブラシの形状（タイル単位）を行ごとの区間として保持
+ * サイズ1〜MAX_SIZE の四角・丸ブラシを初回使用時に全て生成し、以降は参照するだけなので
+ * ブラシの適用ごとのメモリ確保・座標変換は発生しない
+ *
+ * 区間はブラシ中心のタイルからの相対位置で、四角ブラシは従来と同じ範囲
+ * （-(size-1)/2 〜 size/2）を覆う。丸ブラシはその範囲に内接する円に中心が入るタイル
+ */
+class BrushMask {
+public:
+    static constexpr int MAX_SIZE = 64;
+
+    enum class Shape {
+        Square,
+        Round
+    };
+
+    // 1行分の区間 [x0, x1)（dy, x はブラシ中心からの相対タイル位置）
+    struct RowSpan {
+        int dy;
+        int x0;
+        int x1;
+    };
+
+    /**
+     * 形状とサイズに対応するマスク（サイズは1〜MAX_SIZEに丸める）
+     */
+    static const BrushMask& get(Shape shape, int size) {
+        static const std::array<BrushMask, MAX_SIZE * 2> masks = buildAll();
+        size = std::max(1, std::min(MAX_SIZE, size));
+        return masks[(shape == Shape::Round ? MAX_SIZE : 0) + size - 1];
+    }
+
+    static int clampSize(int size) {
+        return std::max(1, std::min(MAX_SIZE, size));
+    }
+
+    const RowSpan* begin() const { return spans.data(); }
+    const RowSpan* end() const { return spans.data() + rowCount; }
+    int getRowCount() const { return rowCount; }
+    int getSize() const { return size; }
+
+private:
+    std::array<RowSpan, MAX_SIZE> spans{};
+    int rowCount = 0;
+    int size = 0;
+
+    static std::array<BrushMask, MAX_SIZE * 2> buildAll() {
+        std::array<BrushMask, MAX_SIZE * 2> masks;
+        for (int size = 1; size <= MAX_SIZE; ++size) {
+            masks[size - 1] = build(Shape::Square, size);
+            masks[MAX_SIZE + size - 1] = build(Shape::Round, size);
+        }
+        return masks;
+    }
+
+    static BrushMask build(Shape shape, int size) {
+        BrushMask mask;
+        mask.size = size;
+        const int start = -(size - 1) / 2;
+        const int end = size / 2;
+
+        if (shape == Shape::Square) {
+            for (int dy = start; dy <= end; ++dy) {
+                mask.spans[mask.rowCount++] = RowSpan{ dy, start, end + 1 };
+            }
+            return mask;
+        }
+
+        // タイル中心と円の中心の距離で判定（半径をわずかに縮め、サイズ3が十字になるようにする）
+        const double center = (start + end) * 0.5;
+        const double radius = size * 0.5 - 0.1;
+        const double threshold = radius * radius;
+        for (int dy = start; dy <= end; ++dy) {
+            const double offsetY = dy - center;
+            int x0 = end + 1, x1 = start;
+            for (int dx = start; dx <= end; ++dx) {
+                const double offsetX = dx - center;
+                if (offsetX * offsetX + offsetY * offsetY <= threshold) {
+                    x0 = std::min(x0, dx);
+                    x1 = std::max(x1, dx + 1);
+                }
+            }
+            if (x0 < x1) {
+                mask.spans[mask.rowCount++] = RowSpan{ dy, x0, x1 };
+            }
+        }
+        return mask;
+    }
+};
@@ -2,6 +2,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <string>
+#include "UIHelper.hpp"
 
 class Button {
 private:
@@ -35,9 +36,11 @@ public:
     /**
      * {^̏ԂXV
      * @param mousePos }EXʒu
+     * @return zo[Ԃωꍇtrue
      */
-    void update(const sf::Vector2i& mousePos) {
+    bool update(const sf::Vector2i& mousePos) {
         sf::FloatRect bounds = shape.getGlobalBounds();
+        const bool wasHovered = isHovered;
         isHovered = bounds.contains(static_cast<sf::Vector2f>(mousePos));
 
         // zo[̐FύX
@@ -47,6 +50,7 @@ public:
         else {
             shape.setFillColor(sf::Color(70, 70, 70));
         }
+        return isHovered != wasHovered;
     }
 
     bool isClicked(const sf::Vector2i& mousePos, bool mousePressed) {
@@ -57,31 +61,46 @@ public:
         return false;
     }
 
-    void draw(sf::RenderWindow& window, const sf::Font& font) {
-        // {^̏ԂɉĐF
-        sf::Color buttonColor;
+    /**
+     * {^̏ԂɉhF擾
+     * @return ANeBuEzo[Eʏ̂ꂩ̐F
+     */
+    sf::Color getStateColor() const {
         if (isActiveState) {
-            buttonColor = ACTIVE_COLOR;     // ANeBuF邢
+            return ACTIVE_COLOR;     // ANeBuF邢
         }
-        else if (isHovered) {
-            buttonColor = HOVER_COLOR;      // zo[FO[
-        }
-        else {
-            buttonColor = NORMAL_COLOR;     // ʏ펞F_[NO[
+        if (isHovered) {
+            return HOVER_COLOR;      // zo[FO[
         }
+        return NORMAL_COLOR;         // ʏ펞F_[NO[
+    }
 
-        shape.setFillColor(buttonColor);
+    void draw(sf::RenderWindow& window, const sf::Font& font) {
+        shape.setFillColor(getStateColor());
         window.draw(shape);
+        drawLabel(window, font);
+    }
 
-        // eLXg`
-        sf::Text buttonText(text, font, 12);
-        sf::FloatRect textBounds = buttonText.getLocalBounds();
-        buttonText.setPosition(
+    /**
+     * {^̔wiƘg𒸓_zisf::Quadsj֒ǉ
+     * ̃{^܂Ƃ߂1ŕ`悷ꍇɎgp
+     */
+    void appendShape(sf::VertexArray& vertices) const {
+        appendQuad(vertices, position.x, position.y, size.x, size.y, getStateColor());
+        appendOutline(vertices, position.x, position.y, size.x, size.y, 1, sf::Color(100, 100, 100));
+    }
+
+    /**
+     * {^̃eLXĝݕ`
+     */
+    void drawLabel(sf::RenderWindow& window, const sf::Font& font) const {
+        // x͌Œ蕶Ȃ̂ŃCAEgς݂̃eLXgėp
+        TextCache& textCache = TextCache::shared();
+        sf::FloatRect textBounds = textCache.get(font, text, 12).getLocalBounds();
+        textCache.draw(window, font, text, 12, sf::Vector2f(
             position.x + (size.x - textBounds.width) / 2,
             position.y + (size.y - textBounds.height) / 2 - 2
-        );
-        buttonText.setFillColor(sf::Color::White);
-        window.draw(buttonText);
+        ), sf::Color::White);
     }
 
     /**
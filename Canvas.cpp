@@ -1,18 +1,156 @@
 #include "Canvas.hpp"
 #include "CanvasView.hpp"  // CanvasViewCN[h
+#include "SoftwareRasterizer.hpp"
+#include "PngStreamWriter.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
 
 // ===== ̃\bhiύXȂj =====
 
-void Canvas::initializeRenderTexture() {
-    if (!renderTexture.create(width * tileSize, height * tileSize)) {
-        std::cerr << "Error: Failed to create render texture" << std::endl;
-        return;
+void Canvas::initializeChunks() {
+    // `N1̃sNZTCYGPȔ CHUNK_MAX_PIXELS 𒴂Ȃ悤Ɍ
+    int maxPixels = std::min(CHUNK_MAX_PIXELS, static_cast<int>(sf::Texture::getMaximumSize()));
+    chunkTiles = std::max(1, std::min(CHUNK_MAX_TILES, maxPixels / tileSize));
+    chunksX = (width + chunkTiles - 1) / chunkTiles;
+    chunksY = (height + chunkTiles - 1) / chunkTiles;
+
+    chunks.clear();
+    chunks.resize(chunksX * chunksY);
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            CanvasChunk& chunk = chunks[cy * chunksX + cx];
+            chunk.tileRect = sf::IntRect(cx * chunkTiles, cy * chunkTiles,
+                std::min(chunkTiles, width - cx * chunkTiles),
+                std::min(chunkTiles, height - cy * chunkTiles));
+        }
     }
+
+    emptyChunkTexture.reset();
+    emptyChunkLodTexture.reset();
+    tileCountsStale = true;
     isInitialized = true;
+
+    // VF[_[̉ۂGLReLXgKvȂߏ`掞ɔ
+    if (!indexedChecked) {
+        indexedSupported = indexedPalette.initialize();
+        indexedChecked = true;
+    }
     isDirty = true;
 }
 
+void Canvas::recountChunkTiles() {
+    for (auto& chunk : chunks) {
+        chunk.filledTiles = tiles.countFilled(chunk.tileRect);
+    }
+    tileCountsStale = false;
+}
+
+bool Canvas::writeTile(int x, int y, int tileIndex) {
+    tileIndex = TileGrid::toCell(tileIndex);
+    const int current = tiles.get(x, y);
+    if (current == tileIndex) return false;
+
+    // `NƂ̎gp^CXVi`ÑeNX`Ɏgpj
+    if (isInitialized && !tileCountsStale) {
+        CanvasChunk& chunk = chunkAt(x, y);
+        if (current < 0 && tileIndex >= 0) chunk.filledTiles++;
+        else if (current >= 0 && tileIndex < 0) chunk.filledTiles--;
+    }
+    if (isInitialized && tileIndex >= 0 && tileIndex < PatternAtlas::MAX_SLOTS) {
+        chunkAt(x, y).usedPatterns |= (uint64_t(1) << tileIndex);
+    }
+
+    tiles.set(x, y, tileIndex);
+    markTileDirty(x, y);
+
+    // ڕ`p̒_Ɋ܂܂^CȂĐ
+    if (directGeometryValid && directTileRange.contains(x, y)) {
+        directGeometryValid = false;
+    }
+    return true;
+}
+
+int Canvas::fillTileSpan(int y, int x0, int x1, int tileIndex) {
+    if (y < 0 || y >= height) return 0;
+    x0 = std::max(0, x0);
+    x1 = std::min(width, x1);
+    if (x1 <= x0) return 0;
+    tileIndex = TileGrid::toCell(tileIndex);
+
+    // `NEŕA`NƂɎgpEgpp^[EύX`܂Ƃ߂čXV
+    const bool trackChunks = isInitialized && !chunks.empty();
+    int changed = 0;
+    for (int x = x0; x < x1;) {
+        const int segmentEnd = trackChunks ? std::min(x1, (x / chunkTiles + 1) * chunkTiles) : x1;
+        const sf::IntRect span(x, y, segmentEnd - x, 1);
+
+        const TileGrid::RowWrite written = tiles.fillRowSpan(y, x, segmentEnd, tileIndex);
+        if (written.changed > 0) {
+            if (trackChunks) {
+                CanvasChunk& chunk = chunkAt(x, y);
+                if (!tileCountsStale) {
+                    chunk.filledTiles += written.filledDelta;
+                }
+                if (tileIndex >= 0 && tileIndex < PatternAtlas::MAX_SLOTS) {
+                    chunk.usedPatterns |= (uint64_t(1) << tileIndex);
+                }
+                markRectDirty(span);
+            }
+            if (directGeometryValid && span.intersects(directTileRange)) {
+                directGeometryValid = false;
+            }
+            changed += written.changed;
+        }
+        x = segmentEnd;
+    }
+    return changed;
+}
+
+int Canvas::writeTileRow(int y, int x0, const TileGrid::Cell* values, int count) {
+    if (y < 0 || y >= height) return 0;
+    int x1 = std::min(width, x0 + count);
+    if (x0 < 0) {
+        values -= x0;
+        x0 = 0;
+    }
+    if (x1 <= x0) return 0;
+
+    // `NEŕAԂƂɈꊇŏłgpEgpp^[EύX`XV
+    // lςȂԂ͍ĕ`_̍ĐȂ
+    const bool trackChunks = isInitialized && !chunks.empty();
+    int changed = 0;
+    for (int x = x0; x < x1;) {
+        const int segmentEnd = trackChunks ? std::min(x1, (x / chunkTiles + 1) * chunkTiles) : x1;
+        const sf::IntRect span(x, y, segmentEnd - x, 1);
+        const TileGrid::Cell* source = values + (x - x0);
+
+        const TileGrid::RowWrite written = tiles.writeRow(y, x, source, span.width);
+        if (written.changed > 0) {
+            if (trackChunks) {
+                CanvasChunk& chunk = chunkAt(x, y);
+                if (!tileCountsStale) {
+                    chunk.filledTiles += written.filledDelta;
+                }
+                for (int i = 0; i < span.width; ++i) {
+                    const int tileIndex = source[i];
+                    if (tileIndex >= 0 && tileIndex < PatternAtlas::MAX_SLOTS) {
+                        chunk.usedPatterns |= (uint64_t(1) << tileIndex);
+                    }
+                }
+                markRectDirty(span);
+            }
+            if (directGeometryValid && span.intersects(directTileRange)) {
+                directGeometryValid = false;
+            }
+            changed += written.changed;
+        }
+        x = segmentEnd;
+    }
+    return changed;
+}
+
 void Canvas::handleClick(const sf::Vector2i& mousePos, int selectedTileIndex) {
     if (selectedTileIndex < 0) return;
 
@@ -21,121 +159,713 @@ void Canvas::handleClick(const sf::Vector2i& mousePos, int selectedTileIndex) {
     int y = static_cast<int>(localPos.y) / tileSize;
 
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        if (tiles[y][x] != selectedTileIndex) {
-            tiles[y][x] = selectedTileIndex;
-            isDirty = true;
+        writeTile(x, y, selectedTileIndex);
+    }
+}
+
+// ===== ob``p̋ʏ =====
+
+namespace {
+    // 1drawő钸_̏iLoXł̈ꎞ}j
+    const std::size_t BATCH_VERTEX_LIMIT = 65536 * 4;
+
+    const sf::Color BACKGROUND_COLOR(40, 40, 40);
+    const sf::Color GRID_LINE_COLOR(70, 70, 70);
+    // \̃ObhI[o[Ci^C̏ɏd˂邽ߔj
+    const sf::Color GRID_OVERLAY_COLOR(70, 70, 70, 160);
+    // Obh̉ʏ̍ŏԊui薧ɂȂꍇ͐Ԉj
+    const float GRID_MIN_SCREEN_SPACING = 4.0f;
+
+    // sȋ`QuadƂĒǉ
+    inline void appendQuad(sf::VertexArray& vertices, float left, float top,
+        float w, float h, const sf::Color& color) {
+        vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left + w, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left + w, top + h), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left, top + h), color));
+    }
+}
+
+sf::Color Canvas::getChunkBackgroundColor() const {
+    return chunksIndexed ? IndexedPalette::encode(IndexedPalette::SLOT_BACKGROUND) : BACKGROUND_COLOR;
+}
+
+bool Canvas::canUseIndexedRendering(const std::array<sf::Color, 16>& globalColors) const {
+    if (!indexedSupported || tileGridColor.a != 255) return false;
+    for (const auto& color : globalColors) {
+        if (color.a != 255) return false;
+    }
+    return true;
+}
+
+void Canvas::updateIndexedPalette(const std::array<sf::Color, 16>& globalColors) {
+    for (int i = 0; i < IndexedPalette::GLOBAL_COLOR_COUNT; ++i) {
+        indexedPalette.setColor(i, globalColors[i]);
+    }
+    indexedPalette.setColor(IndexedPalette::SLOT_BACKGROUND, BACKGROUND_COLOR);
+    indexedPalette.setColor(IndexedPalette::SLOT_TILE_GRID, tileGridColor);
+    indexedPalette.setColor(IndexedPalette::SLOT_FALLBACK, sf::Color::Black);
+}
+
+void Canvas::encodeGlobalColorSets(const std::vector<std::array<int, 3>>& globalColorIndices,
+    std::vector<std::array<sf::Color, 3>>& colorSets) {
+
+    colorSets.resize(globalColorIndices.size());
+    for (std::size_t p = 0; p < globalColorIndices.size(); ++p) {
+        for (int i = 0; i < 3; ++i) {
+            int globalIndex = globalColorIndices[p][i];
+            bool valid = globalIndex >= 0 && globalIndex < IndexedPalette::GLOBAL_COLOR_COUNT;
+            colorSets[p][i] = IndexedPalette::encode(valid ? globalIndex : IndexedPalette::SLOT_FALLBACK);
         }
     }
 }
 
-// renderToTexture \bhXV
-// renderToTexture \bh̏CiȒPȕύX̂݁j
-void Canvas::renderToTexture(const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<sf::Color, 3>>& colorPalettes,
-    bool showGrid, float spacing, float shrink) {
+uint64_t Canvas::renderTileRegion(sf::RenderTarget& target, const sf::IntRect& tileRect,
+    const sf::Vector2f& origin, const PatternAtlas& atlas) {
 
-    // wiF̐ݒiύXȂj
-    renderTexture.clear(sf::Color(40, 40, 40));
+    // ^C`FAgX^CƂ1̃eNX`tQuad𐶐Ă܂Ƃ߂ĕ`
+    sf::RenderStates states;
+    states.texture = &atlas.getTexture();
+    const int slotCount = atlas.getSlotCount();
+    uint64_t usedPatterns = 0;
 
-    // Obh`iS̃Obh - ύXȂj
-    if (showGrid) {
-        sf::VertexArray lines(sf::Lines);
+    batchVertices.setPrimitiveType(sf::Quads);
+    batchVertices.clear();
+
+    for (int y = tileRect.top; y < tileRect.top + tileRect.height; ++y) {
+        // ̃`NɊ܂܂Ԃ͖K₳Ȃ
+        tiles.forEachRowSegment(y, tileRect.left, tileRect.left + tileRect.width,
+            [&](int segmentX, const TileGrid::Cell* segment, int count) {
+                for (int i = 0; i < count; ++i) {
+                    int tileIndex = segment[i];
+
+                    // ȃ^CE͈͊Õp^[̓XLbv
+                    if (tileIndex < 0 || tileIndex >= slotCount) continue;
+
+                    usedPatterns |= (uint64_t(1) << tileIndex);
+                    atlas.appendTileQuad(batchVertices, (segmentX + i) * tileSize - origin.x,
+                        y * tileSize - origin.y, tileIndex);
+                }
+            });
+
+        // sPʂŏ`FbNătbV
+        if (batchVertices.getVertexCount() >= BATCH_VERTEX_LIMIT) {
+            target.draw(batchVertices, states);
+            batchVertices.clear();
+        }
+    }
+
+    if (batchVertices.getVertexCount() > 0) {
+        target.draw(batchVertices, states);
+        batchVertices.clear();
+    }
+
+    return usedPatterns;
+}
+
+PatternAtlas::Settings Canvas::getAtlasSettings(float spacing, float shrink) const {
+    PatternAtlas::Settings settings;
+    settings.tileSize = tileSize;
+    settings.spacing = spacing;
+    settings.shrink = shrink;
+    settings.useTileGridColor = useTileGridColor;
+    settings.tileGridColor = tileGridColor;
+    return settings;
+}
+
+void Canvas::updatePatternAtlas(const std::vector<PaletteSnapshot::Cells>& cells,
+    const std::vector<std::array<sf::Color, 3>>& colorSets,
+    float spacing, float shrink) {
+
+    PatternAtlas::Settings settings = getAtlasSettings(spacing, shrink);
+    if (chunksIndexed) {
+        // ^CObhFXbgԍŏĂ݁AF̕ύX̓e[uŔf
+        settings.tileGridColor = IndexedPalette::encode(IndexedPalette::SLOT_TILE_GRID);
+    }
+
+    uint64_t changedSlots = patternAtlas.update(cells, colorSets, settings);
+    paletteDirty = false;
+    if (changedSlots == 0) return;
+
+    // ύXꂽp^[܂ރ`N̂ݍĕ`Ώۂɂ
+    for (auto& chunk : chunks) {
+        if (chunk.usedPatterns & changedSlots) {
+            chunk.needsFullRedraw = true;
+            chunk.dirtyRects.clear();
+        }
+    }
+}
+
+void Canvas::markRectDirty(const sf::IntRect& rect) {
+    // S̍ĕ`悪\肳Ăꍇ͋L^sv
+    if (!isInitialized || isDirty) return;
+
+    CanvasChunk& chunk = chunkAt(rect.left, rect.top);
+    if (chunk.needsFullRedraw) return;
+
+    std::vector<sf::IntRect>& dirtyRects = chunk.dirtyRects;
+
+    // Ő`ɐڂĂꍇ͊gČiXg[N͂قڂj
+    if (!dirtyRects.empty()) {
+        sf::IntRect& last = dirtyRects.back();
+        if (rect.left + rect.width >= last.left && rect.left <= last.left + last.width &&
+            rect.top + rect.height >= last.top && rect.top <= last.top + last.height) {
+            int right = std::max(last.left + last.width, rect.left + rect.width);
+            int bottom = std::max(last.top + last.height, rect.top + rect.height);
+            last.left = std::min(last.left, rect.left);
+            last.top = std::min(last.top, rect.top);
+            last.width = right - last.left;
+            last.height = bottom - last.top;
+            return;
+        }
+    }
+
+    dirtyRects.push_back(rect);
+
+    // `ꍇ͊Oڋ`1ɂ܂Ƃ߂
+    if (dirtyRects.size() > MAX_DIRTY_RECTS) {
+        int left = width, top = height, right = 0, bottom = 0;
+        for (const auto& rect : dirtyRects) {
+            left = std::min(left, rect.left);
+            top = std::min(top, rect.top);
+            right = std::max(right, rect.left + rect.width);
+            bottom = std::max(bottom, rect.top + rect.height);
+        }
+        dirtyRects.clear();
+        dirtyRects.push_back(sf::IntRect(left, top, right - left, bottom - top));
+    }
+}
+
+void Canvas::renderChunk(CanvasChunk& chunk) {
+
+    sf::Vector2f origin(static_cast<float>(chunk.tileRect.left * tileSize),
+        static_cast<float>(chunk.tileRect.top * tileSize));
+
+    chunk.texture->clear(getChunkBackgroundColor());
+    chunk.usedPatterns = renderTileRegion(*chunk.texture, chunk.tileRect, origin, patternAtlas);
+    chunk.texture->display();
+
+    chunk.needsFullRedraw = false;
+    chunk.dirtyRects.clear();
+    chunk.lodNeedsFullRedraw = true;
+    chunk.lodDirtyRects.clear();
+}
+
+void Canvas::renderChunkDirtyRegions(CanvasChunk& chunk) {
+
+    sf::RenderTexture& target = *chunk.texture;
+    const sf::Vector2f origin(static_cast<float>(chunk.tileRect.left * tileSize),
+        static_cast<float>(chunk.tileRect.top * tileSize));
+    const float textureWidth = static_cast<float>(chunk.tileRect.width * tileSize);
+    const float textureHeight = static_cast<float>(chunk.tileRect.height * tileSize);
+    const sf::View defaultView = target.getDefaultView();
+    const sf::Color backgroundColor = getChunkBackgroundColor();
+
+    for (const auto& rect : chunk.dirtyRects) {
+        // ̈Oւ̕`h߁AύẌ悾𕢂r[|[gݒ
+        sf::FloatRect pixelRect(
+            rect.left * tileSize - origin.x, rect.top * tileSize - origin.y,
+            static_cast<float>(rect.width * tileSize), static_cast<float>(rect.height * tileSize));
+
+        sf::View regionView(pixelRect);
+        regionView.setViewport(sf::FloatRect(
+            pixelRect.left / textureWidth, pixelRect.top / textureHeight,
+            pixelRect.width / textureWidth, pixelRect.height / textureHeight));
+        target.setView(regionView);
+
+        // wiœhԂiclear̓r[|[g𖳎邽Quadőpj
+        batchVertices.setPrimitiveType(sf::Quads);
+        batchVertices.clear();
+        appendQuad(batchVertices, pixelRect.left, pixelRect.top,
+            pixelRect.width, pixelRect.height, backgroundColor);
+        target.draw(batchVertices);
+        batchVertices.clear();
+
+        // ̈Ɋ|^Cĕ`
+        chunk.usedPatterns |= renderTileRegion(target, rect, origin, patternAtlas);
+    }
+
+    target.setView(defaultView);
+    target.display();
+
+    // LODɂ͓`𔽉fiꍇ͑Ŝkj
+    if (!chunk.lodNeedsFullRedraw) {
+        chunk.lodDirtyRects.insert(chunk.lodDirtyRects.end(), chunk.dirtyRects.begin(), chunk.dirtyRects.end());
+        if (chunk.lodDirtyRects.size() > MAX_DIRTY_RECTS) {
+            chunk.lodNeedsFullRedraw = true;
+            chunk.lodDirtyRects.clear();
+        }
+    }
+    chunk.dirtyRects.clear();
+}
+
+const sf::Texture* Canvas::getEmptyChunkTexture() {
+    if (!emptyChunkTexture) {
+        emptyChunkTexture = std::make_unique<sf::RenderTexture>();
+        if (!emptyChunkTexture->create(chunkTiles * tileSize, chunkTiles * tileSize)) {
+            std::cerr << "Error: Failed to create empty chunk texture" << std::endl;
+            emptyChunkTexture.reset();
+            return nullptr;
+        }
+        emptyChunkValid = false;
+    }
+
+    // `N͔wî݂Ȃ̂őS`N1L
+    if (!emptyChunkValid) {
+        emptyChunkTexture->clear(getChunkBackgroundColor());
+        emptyChunkTexture->display();
+        emptyChunkValid = true;
+    }
+
+    return &emptyChunkTexture->getTexture();
+}
+
+void Canvas::updateVisibleChunks(const sf::FloatRect& localVisibleArea) {
+
+    // S̖͊e`Nւ̃tOݒ̂݁iۂ̍ĕ`͕\܂Œxj
+    if (isDirty) {
+        for (auto& chunk : chunks) {
+            chunk.needsFullRedraw = true;
+            chunk.dirtyRects.clear();
+        }
+        emptyChunkValid = false;
+        emptyChunkLodValid = false;
+        isDirty = false;
+    }
+
+    if (tileCountsStale) {
+        recountChunkTiles();
+    }
+
+    ++chunkFrame;
+    for (auto& chunk : chunks) {
+        if (!localVisibleArea.intersects(getChunkPixelRect(chunk))) continue;
+        chunk.lastVisibleFrame = chunkFrame;
 
-        // c
-        for (int x = 0; x <= width; ++x) {
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, 0), sf::Color(70, 70, 70)));
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, height * tileSize), sf::Color(70, 70, 70)));
+        // ̃`N̓eNX`ȂiVRAM͓eʂɔj
+        if (chunk.filledTiles == 0) {
+            if (chunk.texture) {
+                chunk.texture.reset();
+                chunk.lodTexture.reset();
+            }
+            chunk.needsFullRedraw = true;
+            chunk.dirtyRects.clear();
+            continue;
+        }
+
+        if (!chunk.texture) {
+            chunk.texture = std::make_unique<sf::RenderTexture>();
+            if (!chunk.texture->create(chunk.tileRect.width * tileSize, chunk.tileRect.height * tileSize)) {
+                std::cerr << "Error: Failed to create chunk texture" << std::endl;
+                chunk.texture.reset();
+                continue;
+            }
+            chunk.needsFullRedraw = true;
         }
 
-        // 
-        for (int y = 0; y <= height; ++y) {
-            lines.append(sf::Vertex(sf::Vector2f(0, y * tileSize), sf::Color(70, 70, 70)));
-            lines.append(sf::Vertex(sf::Vector2f(width * tileSize, y * tileSize), sf::Color(70, 70, 70)));
+        if (chunk.needsFullRedraw) {
+            renderChunk(chunk);
+        }
+        else if (!chunk.dirtyRects.empty()) {
+            // ύXꂽ^C̈̂ݍĕ`
+            renderChunkDirtyRegions(chunk);
         }
+    }
+}
 
-        renderTexture.draw(lines);
+void Canvas::drawVisibleChunks(sf::RenderTarget& target, const sf::RenderStates& states,
+    const sf::FloatRect& localVisibleArea, bool useLod) {
+
+    // CfbNX`̃eNX`̓bNAbve[uVF[_[ʂĕ\iLOD͐Fς݁j
+    sf::RenderStates indexedStates = states;
+    if (chunksIndexed) {
+        indexedStates.shader = indexedPalette.getShader();
     }
 
-    // ===== CF^C`i^CEObhΉj =====
-    float cellSize = tileSize / 3.0f;
-    sf::RectangleShape cell;
+    sf::Sprite sprite;
+    for (const auto& chunk : chunks) {
+        sf::FloatRect chunkRect = getChunkPixelRect(chunk);
+        if (!localVisibleArea.intersects(chunkRect)) continue;
+
+        const sf::Vector2i fullSize(static_cast<int>(chunkRect.width), static_cast<int>(chunkRect.height));
+        const sf::Vector2i lodSize((fullSize.x + 1) / 2, (fullSize.y + 1) / 2);
+
+        // LODD悵ApӂłȂꍇ͒ʏ̃eNX`ŕ\
+        const sf::Texture* texture = nullptr;
+        bool isLod = false;
+        if (useLod) {
+            texture = chunk.texture ? (chunk.lodTexture ? &chunk.lodTexture->getTexture() : nullptr)
+                : getEmptyChunkLodTexture();
+            isLod = texture != nullptr;
+        }
+        if (!texture) {
+            texture = chunk.texture ? &chunk.texture->getTexture() : getEmptyChunkTexture();
+        }
+        if (!texture) continue;
+
+        // LOD̓eNX`1sNZ2sNZi[̓`N͈͂ɍ킹ĐLkj
+        const sf::Vector2i textureSize = isLod ? lodSize : fullSize;
+        sprite.setTexture(*texture);
+        sprite.setTextureRect(sf::IntRect(0, 0, textureSize.x, textureSize.y));
+        sprite.setScale(chunkRect.width / textureSize.x, chunkRect.height / textureSize.y);
+        sprite.setPosition(position.x + chunkRect.left, position.y + chunkRect.top);
+        target.draw(sprite, isLod ? states : indexedStates);
+    }
+}
 
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int tileIndex = tiles[y][x];
+void Canvas::downsampleTexture(sf::RenderTexture& source, sf::RenderTexture& target, const sf::FloatRect* region) {
+    sf::Sprite sprite(source.getTexture());
+    sprite.setScale(0.5f, 0.5f);
 
-            // ȃ^C̏ꍇ̓XLbv
-            if (tileIndex < 0) continue;
+    // nƍu
+    sf::RenderStates states(sf::BlendNone);
 
-            // ͈̓`FbN
-            if (tileIndex >= patterns.size() || tileIndex >= colorPalettes.size()) {
+    // CfbNX`ł̓VF[_[ŐFɕϊĂ畽ρAʏ`ł̓oCjAԂŕ
+    // io̓sNZSk2x2sNZ̒Sɓ邽߁AԌʂ4sNZ̕ςɂȂj
+    const sf::Shader* shader = chunksIndexed ? indexedPalette.getDownsampleShader(source.getSize()) : nullptr;
+    if (shader) {
+        states.shader = shader;
+    }
+    else {
+        source.setSmooth(true);
+    }
+
+    const sf::Vector2u targetSize = target.getSize();
+    if (region) {
+        // ύX͈͂܂LODsNZ͈݂͂̂Ƀr[|[g𐧌
+        float left = std::floor(region->left * 0.5f);
+        float top = std::floor(region->top * 0.5f);
+        float right = std::min(static_cast<float>(targetSize.x), std::ceil((region->left + region->width) * 0.5f));
+        float bottom = std::min(static_cast<float>(targetSize.y), std::ceil((region->top + region->height) * 0.5f));
+
+        sf::View regionView(sf::FloatRect(left, top, right - left, bottom - top));
+        regionView.setViewport(sf::FloatRect(left / targetSize.x, top / targetSize.y,
+            (right - left) / targetSize.x, (bottom - top) / targetSize.y));
+        target.setView(regionView);
+    }
+    else {
+        target.clear(sf::Color::Transparent);
+    }
+
+    target.draw(sprite, states);
+    target.setView(target.getDefaultView());
+
+    if (!shader) {
+        source.setSmooth(false);
+    }
+}
+
+bool Canvas::isLodPaletteCurrent(uint64_t lodPaletteVersion) const {
+    return !chunksIndexed || lodPaletteVersion == indexedPalette.getColorVersion();
+}
+
+void Canvas::releaseOffscreenChunkTextures(const sf::FloatRect& localVisibleArea) {
+    auto textureBytes = [](const std::unique_ptr<sf::RenderTexture>& texture) -> std::size_t {
+        if (!texture) return 0;
+        const sf::Vector2u size = texture->getSize();
+        return static_cast<std::size_t>(size.x) * size.y * 4;
+    };
+
+    std::size_t totalBytes = 0;
+    releaseCandidates.clear();
+    for (int i = 0; i < static_cast<int>(chunks.size()); ++i) {
+        const CanvasChunk& chunk = chunks[i];
+        if (!chunk.texture) continue;
+        totalBytes += textureBytes(chunk.texture) + textureBytes(chunk.lodTexture);
+        if (!localVisibleArea.intersects(getChunkPixelRect(chunk))) {
+            releaseCandidates.push_back(i);
+        }
+    }
+    if (totalBytes <= CHUNK_TEXTURE_BUDGET_BYTES) return;
+
+    // Ōɕ\ꂽ̂Âɉi\͈͓̃`N͑ΏۊOj
+    std::sort(releaseCandidates.begin(), releaseCandidates.end(), [this](int a, int b) {
+        return chunks[a].lastVisibleFrame < chunks[b].lastVisibleFrame;
+    });
+    for (int index : releaseCandidates) {
+        if (totalBytes <= CHUNK_TEXTURE_BUDGET_BYTES) break;
+        CanvasChunk& chunk = chunks[index];
+        totalBytes -= textureBytes(chunk.texture) + textureBytes(chunk.lodTexture);
+        chunk.texture.reset();
+        chunk.lodTexture.reset();
+        chunk.needsFullRedraw = true;
+        chunk.dirtyRects.clear();
+        chunk.lodNeedsFullRedraw = true;
+        chunk.lodDirtyRects.clear();
+    }
+}
+
+void Canvas::updateVisibleChunkLods(const sf::FloatRect& localVisibleArea) {
+    for (auto& chunk : chunks) {
+        if (!chunk.texture || chunk.needsFullRedraw) continue;
+        if (!localVisibleArea.intersects(getChunkPixelRect(chunk))) continue;
+
+        if (!chunk.lodTexture) {
+            const sf::Vector2u size = chunk.texture->getSize();
+            chunk.lodTexture = std::make_unique<sf::RenderTexture>();
+            if (!chunk.lodTexture->create((size.x + 1) / 2, (size.y + 1) / 2)) {
+                std::cerr << "Error: Failed to create chunk LOD texture" << std::endl;
+                chunk.lodTexture.reset();
                 continue;
             }
+            chunk.lodNeedsFullRedraw = true;
+        }
 
-            const auto& pattern = patterns[tileIndex];
-            const auto& colorSet = colorPalettes[tileIndex];
-
-            // ===== VF^CEObh̕` =====
-            if (useTileGridColor && spacing > 0.0f) {
-                // ^CŜ̗̈^CObhFœhԂ
-                sf::RectangleShape tileBackground(sf::Vector2f(tileSize, tileSize));
-                tileBackground.setPosition(x * tileSize, y * tileSize);
-                tileBackground.setFillColor(tileGridColor);
-                renderTexture.draw(tileBackground);
-
-                // ̕`̈vZispacingɁj
-                float borderWidth = tileSize * spacing * 0.5f;  // spacing E̕ƂĎgp
-                float innerTileSize = tileSize - (borderWidth * 2);
-                float innerCellSize = innerTileSize / 3.0f;
-
-                // 3x3p^[̗̈ɕ`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                // ZTCY shrink Œ
-                                float adjustedCellSize = innerCellSize * shrink;
-                                float cellCenterOffset = (innerCellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + borderWidth + cx * innerCellSize + cellCenterOffset,
-                                    y * tileSize + borderWidth + cy * innerCellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                renderTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
+        if (!isLodPaletteCurrent(chunk.lodPaletteVersion)) {
+            chunk.lodNeedsFullRedraw = true;
+        }
+
+        if (chunk.lodNeedsFullRedraw) {
+            downsampleTexture(*chunk.texture, *chunk.lodTexture, nullptr);
+        }
+        else if (!chunk.lodDirtyRects.empty()) {
+            const sf::Vector2f origin(static_cast<float>(chunk.tileRect.left * tileSize),
+                static_cast<float>(chunk.tileRect.top * tileSize));
+            for (const auto& rect : chunk.lodDirtyRects) {
+                sf::FloatRect pixelRect(rect.left * tileSize - origin.x, rect.top * tileSize - origin.y,
+                    static_cast<float>(rect.width * tileSize), static_cast<float>(rect.height * tileSize));
+                downsampleTexture(*chunk.texture, *chunk.lodTexture, &pixelRect);
             }
-            else {
-                // spacing = 0 ̏ꍇ͏]ʂ̕`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = cellSize * shrink;
-                                float cellCenterOffset = (cellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + cx * cellSize + cellCenterOffset,
-                                    y * tileSize + cy * cellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                renderTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
+        }
+        else {
+            continue;
+        }
+
+        chunk.lodTexture->display();
+        chunk.lodNeedsFullRedraw = false;
+        chunk.lodDirtyRects.clear();
+        chunk.lodPaletteVersion = chunksIndexed ? indexedPalette.getColorVersion() : 0;
+    }
+}
+
+const sf::Texture* Canvas::getEmptyChunkLodTexture() {
+    if (!emptyChunkValid || !emptyChunkLodTexture) {
+        emptyChunkLodValid = false;
+    }
+    if (!isLodPaletteCurrent(emptyChunkLodPaletteVersion)) {
+        emptyChunkLodValid = false;
+    }
+
+    if (!emptyChunkLodValid) {
+        // kiwijɍŐVɂ
+        if (!getEmptyChunkTexture()) return nullptr;
+
+        if (!emptyChunkLodTexture) {
+            const sf::Vector2u size = emptyChunkTexture->getSize();
+            emptyChunkLodTexture = std::make_unique<sf::RenderTexture>();
+            if (!emptyChunkLodTexture->create((size.x + 1) / 2, (size.y + 1) / 2)) {
+                std::cerr << "Error: Failed to create empty chunk LOD texture" << std::endl;
+                emptyChunkLodTexture.reset();
+                return nullptr;
             }
         }
+
+        downsampleTexture(*emptyChunkTexture, *emptyChunkLodTexture, nullptr);
+        emptyChunkLodTexture->display();
+        emptyChunkLodValid = true;
+        emptyChunkLodPaletteVersion = chunksIndexed ? indexedPalette.getColorVersion() : 0;
+    }
+
+    return &emptyChunkLodTexture->getTexture();
+}
+
+void Canvas::drawChunked(sf::RenderWindow& window, const sf::Transform& transform,
+    const sf::FloatRect& visibleArea, float outlineThickness,
+    const std::vector<PaletteSnapshot::Cells>& cells,
+    const std::vector<std::array<sf::Color, 3>>& colorSets,
+    bool showGrid, float spacing, float shrink, bool indexed, float zoom) {
+
+    // `؂ւꍇ̓`NEAgXƂ`
+    if (indexed != chunksIndexed) {
+        chunksIndexed = indexed;
+        isDirty = true;
+    }
+
+    // \̈LoX[JWցiۂߌ덷1^Cgj
+    sf::FloatRect localVisibleArea(
+        visibleArea.left - position.x - tileSize, visibleArea.top - position.y - tileSize,
+        visibleArea.width + tileSize * 2.0f, visibleArea.height + tileSize * 2.0f);
+
+    // pbg܂͐ݒ̕ύX΃AgX̊YXbĝݍĐ
+    if (paletteDirty || isDirty || !patternAtlas.isReady()) {
+        updatePatternAtlas(cells, colorSets, spacing, shrink);
+    }
+
+    if (chunksIndexed) {
+        indexedPalette.upload();
+    }
+
+    // k\łLODgpiCfbNX`掞VF[_[ŐF𕽋ςKv邽ߗp\ȏꍇ̂݁j
+    const bool useLod = zoom < LOD_ZOOM_THRESHOLD && (!chunksIndexed || indexedPalette.hasDownsampleShader());
+
+    if (patternAtlas.isReady()) {
+        updateVisibleChunks(localVisibleArea);
+        if (useLod) {
+            updateVisibleChunkLods(localVisibleArea);
+        }
+        releaseOffscreenChunkTextures(localVisibleArea);
+    }
+
+    sf::RenderStates states;
+    states.transform = transform;
+    drawVisibleChunks(window, states, localVisibleArea, useLod);
+
+    if (showGrid) {
+        drawGridOverlay(window, states, zoom);
+    }
+
+    drawBorder(window, states, outlineThickness);
+}
+
+int Canvas::getGridOverlayStep(float zoom) const {
+    // ̊Ԋuʏ GRID_MIN_SCREEN_SPACING ȏɂȂ܂2{Ԉ
+    const float screenSpacing = tileSize * std::max(zoom, 0.0001f);
+    int step = 1;
+    while (screenSpacing * step < GRID_MIN_SCREEN_SPACING && step < std::max(width, height)) {
+        step *= 2;
+    }
+    return step;
+}
+
+void Canvas::buildGridOverlay(int step) {
+    gridOverlayVertices.setPrimitiveType(sf::Lines);
+    gridOverlayVertices.clear();
+
+    const float left = position.x;
+    const float top = position.y;
+    const float right = position.x + width * tileSize;
+    const float bottom = position.y + height * tileSize;
+
+    // O͋EƏdȂ邽ߓ̐̂
+    for (int x = step; x < width; x += step) {
+        float lineX = position.x + x * tileSize;
+        gridOverlayVertices.append(sf::Vertex(sf::Vector2f(lineX, top), GRID_OVERLAY_COLOR));
+        gridOverlayVertices.append(sf::Vertex(sf::Vector2f(lineX, bottom), GRID_OVERLAY_COLOR));
+    }
+    for (int y = step; y < height; y += step) {
+        float lineY = position.y + y * tileSize;
+        gridOverlayVertices.append(sf::Vertex(sf::Vector2f(left, lineY), GRID_OVERLAY_COLOR));
+        gridOverlayVertices.append(sf::Vertex(sf::Vector2f(right, lineY), GRID_OVERLAY_COLOR));
+    }
+
+    gridOverlaySize = sf::Vector2i(width, height);
+    gridOverlayOrigin = position;
+    gridOverlayTileSize = tileSize;
+    gridOverlayStep = step;
+}
+
+void Canvas::drawGridOverlay(sf::RenderTarget& target, const sf::RenderStates& states, float zoom) {
+    // LoX̑傫EʒuAY[ɂԈԊuςꍇ̂ݒ_Đ
+    const int step = getGridOverlayStep(zoom);
+    if (step != gridOverlayStep || gridOverlaySize != sf::Vector2i(width, height) ||
+        gridOverlayOrigin != position || gridOverlayTileSize != tileSize) {
+        buildGridOverlay(step);
+    }
+
+    // Lines͕ϊ1ʃsNZŕ`悳
+    if (gridOverlayVertices.getVertexCount() > 0) {
+        target.draw(gridOverlayVertices, states);
+    }
+}
+
+void Canvas::drawBorder(sf::RenderTarget& target, const sf::RenderStates& states, float outlineThickness) {
+    // E`
+    sf::RectangleShape border(sf::Vector2f(width * tileSize, height * tileSize));
+    border.setPosition(position);
+    border.setFillColor(sf::Color::Transparent);
+    border.setOutlineThickness(outlineThickness);
+    border.setOutlineColor(sf::Color(100, 100, 100));
+    target.draw(border, states);
+}
+
+void Canvas::buildDirectGeometry(const sf::IntRect& tileRange, const PaletteSnapshot& palette) {
+    directVertices.setPrimitiveType(sf::Quads);
+    directVertices.clear();
+
+    const std::size_t patternCount = std::min(palette.cells.size(), palette.colors.size());
+
+    const float left = position.x + tileRange.left * tileSize;
+    const float top = position.y + tileRange.top * tileSize;
+    const float rangeWidth = static_cast<float>(tileRange.width * tileSize);
+    const float rangeHeight = static_cast<float>(tileRange.height * tileSize);
+
+    // wiiObh̓I[o[CƂĕʂɕ`j
+    appendQuad(directVertices, left, top, rangeWidth, rangeHeight, BACKGROUND_COLOR);
+
+    // ^CiAgXƓ`ʉ𑜓xŕ`j
+    for (int y = tileRange.top; y < tileRange.top + tileRange.height; ++y) {
+        tiles.forEachRowSegment(y, tileRange.left, tileRange.left + tileRange.width,
+            [&](int segmentX, const TileGrid::Cell* segment, int count) {
+                for (int i = 0; i < count; ++i) {
+                    int tileIndex = segment[i];
+                    if (tileIndex < 0 || tileIndex >= static_cast<int>(patternCount)) continue;
+
+                    PatternAtlas::appendTileGeometry(directVertices,
+                        position.x + (segmentX + i) * tileSize, position.y + y * tileSize,
+                        palette.cells[tileIndex], palette.colors[tileIndex], directSettings);
+                }
+            });
+    }
+
+    directTileRange = tileRange;
+    directGeometryValid = true;
+}
+
+void Canvas::drawDirect(sf::RenderWindow& window, const CanvasView& view,
+    const PaletteSnapshot& palette,
+    bool showGrid, float spacing, float shrink) {
+
+    // \͈͂̃^C͈
+    const sf::FloatRect visibleArea = view.getVisibleCanvasArea();
+    const int visibleLeft = std::max(0, static_cast<int>(std::floor((visibleArea.left - position.x) / tileSize)));
+    const int visibleTop = std::max(0, static_cast<int>(std::floor((visibleArea.top - position.y) / tileSize)));
+    const int visibleRight = std::min(width,
+        static_cast<int>(std::ceil((visibleArea.left + visibleArea.width - position.x) / tileSize)));
+    const int visibleBottom = std::min(height,
+        static_cast<int>(std::ceil((visibleArea.top + visibleArea.height - position.y) / tileSize)));
+
+    // f[^EݒEF̕ύXA܂͕\͈͂ςݔ͈͂Oꂽꍇ̂ݒ_Đ
+    const PatternAtlas::Settings settings = getAtlasSettings(spacing, shrink);
+    const PaletteVersions versions(palette);
+    const bool rangeCovered = directTileRange.left <= visibleLeft && directTileRange.top <= visibleTop &&
+        directTileRange.left + directTileRange.width >= visibleRight &&
+        directTileRange.top + directTileRange.height >= visibleBottom;
+
+    if (!directGeometryValid || !rangeCovered || versions != directVersions ||
+        settings != directSettings) {
+
+        directVersions = versions;
+        directSettings = settings;
+
+        const int left = std::max(0, visibleLeft - DIRECT_RANGE_MARGIN);
+        const int top = std::max(0, visibleTop - DIRECT_RANGE_MARGIN);
+        const int right = std::min(width, visibleRight + DIRECT_RANGE_MARGIN);
+        const int bottom = std::min(height, visibleBottom + DIRECT_RANGE_MARGIN);
+        buildDirectGeometry(sf::IntRect(left, top, std::max(0, right - left), std::max(0, bottom - top)), palette);
     }
 
-    renderTexture.display();
+    sf::RenderStates states;
+    states.transform = view.getTransform();
+    if (directVertices.getVertexCount() > 0) {
+        window.draw(directVertices, states);
+    }
+
+    if (showGrid) {
+        drawGridOverlay(window, states, view.getZoom());
+    }
+
+    drawBorder(window, states, 1.0f / view.getZoom());
+}
+
+bool Canvas::applySettings(float spacing, float shrink) {
+    // Obh\̓I[o[Cŕ`߁A؂ւĂLbV͖ɂȂȂ
+    if (spacing != lastSpacing || shrink != lastShrink) {
+        lastSpacing = spacing;
+        lastShrink = shrink;
+        isDirty = true;
+        return true;
+    }
+    return false;
 }
 
 void Canvas::draw(sf::RenderWindow& window,
@@ -146,33 +876,19 @@ void Canvas::draw(sf::RenderWindow& window,
     float shrink) {
 
     if (!isInitialized) {
-        initializeRenderTexture();
+        initializeChunks();
     }
 
-    bool settingsChanged = (showGrid != lastShowGrid ||
-        spacing != lastSpacing ||
-        shrink != lastShrink);
+    applySettings(spacing, shrink);
 
-    if (isDirty || settingsChanged) {
-        renderToTexture(patterns, colorPalettes, showGrid, spacing, shrink);
-        isDirty = false;
-        lastShowGrid = showGrid;
-        lastSpacing = spacing;
-        lastShrink = shrink;
-    }
+    // J[VXe͕ύXʒmȂߖAgXƍ
+    paletteDirty = true;
+    PaletteSnapshot::packCells(patterns, legacyPatternCells);
 
-    if (isInitialized) {
-        sf::Sprite sprite(renderTexture.getTexture());
-        sprite.setPosition(position);
-        window.draw(sprite);
-
-        sf::RectangleShape border(sf::Vector2f(width * tileSize, height * tileSize));
-        border.setPosition(position);
-        border.setFillColor(sf::Color::Transparent);
-        border.setOutlineThickness(1);
-        border.setOutlineColor(sf::Color(100, 100, 100));
-        window.draw(border);
-    }
+    // r[Ȃ̏ꍇ̓LoXŜ\Ώ
+    sf::FloatRect wholeCanvas(position.x, position.y, width * tileSize, height * tileSize);
+    drawChunked(window, sf::Transform::Identity, wholeCanvas, 1.0f,
+        legacyPatternCells, colorPalettes, showGrid, spacing, shrink);
 }
 
 void Canvas::eraseTile(const sf::Vector2i& position) {
@@ -180,8 +896,7 @@ void Canvas::eraseTile(const sf::Vector2i& position) {
     int tileY = (position.y - this->position.y) / tileSize;
 
     if (tileX >= 0 && tileX < width && tileY >= 0 && tileY < height) {
-        tiles[tileY][tileX] = -1;
-        isDirty = true;
+        writeTile(tileX, tileY, -1);
     }
 }
 
@@ -190,8 +905,7 @@ void Canvas::setTile(const sf::Vector2i& position, int tileIndex) {
     int tileY = (position.y - this->position.y) / tileSize;
 
     if (tileX >= 0 && tileX < width && tileY >= 0 && tileY < height) {
-        tiles[tileY][tileX] = tileIndex;
-        isDirty = true;
+        writeTile(tileX, tileY, tileIndex);
     }
 }
 
@@ -206,39 +920,18 @@ void Canvas::drawWithView(sf::RenderWindow& window,
     float shrink) {
 
     if (!isInitialized) {
-        initializeRenderTexture();
-    }
-
-    bool settingsChanged = (showGrid != lastShowGrid ||
-        spacing != lastSpacing ||
-        shrink != lastShrink);
-
-    if (isDirty || settingsChanged) {
-        renderToTexture(patterns, colorPalettes, showGrid, spacing, shrink);
-        isDirty = false;
-        lastShowGrid = showGrid;
-        lastSpacing = spacing;
-        lastShrink = shrink;
+        initializeChunks();
     }
 
-    if (isInitialized) {
-        sf::Sprite sprite(renderTexture.getTexture());
-        sprite.setPosition(position);
+    applySettings(spacing, shrink);
 
-        // CanvasView̕ϊKp
-        sf::RenderStates states;
-        states.transform = view.getTransform();
+    // J[VXe͕ύXʒmȂߖAgXƍ
+    paletteDirty = true;
+    PaletteSnapshot::packCells(patterns, legacyPatternCells);
 
-        window.draw(sprite, states);
-
-        // E`
-        sf::RectangleShape border(sf::Vector2f(width * tileSize, height * tileSize));
-        border.setPosition(position);
-        border.setFillColor(sf::Color::Transparent);
-        border.setOutlineThickness(1.0f / view.getZoom());
-        border.setOutlineColor(sf::Color(100, 100, 100));
-        window.draw(border, states);
-    }
+    // CanvasView̕ϊKpA\͈͂̃`N̂ݕ`
+    drawChunked(window, view.getTransform(), view.getVisibleCanvasArea(), 1.0f / view.getZoom(),
+        legacyPatternCells, colorPalettes, showGrid, spacing, shrink, false, view.getZoom());
 }
 
 bool Canvas::containsInView(const CanvasView& view, const sf::Vector2i& screenPos) const {
@@ -256,11 +949,7 @@ void Canvas::handleClickInView(const CanvasView& view, const sf::Vector2i& scree
 
     if (tileIndex.x >= 0 && tileIndex.x < width &&
         tileIndex.y >= 0 && tileIndex.y < height) {
-
-        if (tiles[tileIndex.y][tileIndex.x] != patternIndex) {
-            tiles[tileIndex.y][tileIndex.x] = patternIndex;
-            isDirty = true;
-        }
+        writeTile(tileIndex.x, tileIndex.y, patternIndex);
     }
 }
 
@@ -271,16 +960,10 @@ void Canvas::eraseTileInView(const CanvasView& view, const sf::Vector2i& screenP
 
     if (tileIndex.x >= 0 && tileIndex.x < width &&
         tileIndex.y >= 0 && tileIndex.y < height) {
-
-        if (tiles[tileIndex.y][tileIndex.x] != -1) {
-            tiles[tileIndex.y][tileIndex.x] = -1;
-            isDirty = true;
-        }
+        writeTile(tileIndex.x, tileIndex.y, -1);
     }
 }
 
-/*
-
 Canvas::PerformanceInfo Canvas::getPerformanceInfo(const CanvasView& view) const {
     PerformanceInfo info;
     info.totalTiles = width * height;
@@ -293,26 +976,20 @@ Canvas::PerformanceInfo Canvas::getPerformanceInfo(const CanvasView& view) const
     int endX = std::min(width, static_cast<int>((visibleArea.left + visibleArea.width - position.x) / tileSize) + 1);
     int endY = std::min(height, static_cast<int>((visibleArea.top + visibleArea.height - position.y) / tileSize) + 1);
 
-    info.visibleTiles = (endX - startX) * (endY - startY);
+    info.visibleTiles = std::max(0, endX - startX) * std::max(0, endY - startY);
 
-    info.drawnTiles = 0;
-    for (int y = startY; y < endY; ++y) {
-        for (int x = startX; x < endX; ++x) {
-            if (x >= 0 && x < width && y >= 0 && y < height && tiles[y][x] >= 0) {
-                info.drawnTiles++;
-            }
-        }
-    }
+    // zuς݃^C̓`NPʂ̏WvgÃ`N͑Ȃ
+    info.drawnTiles = tiles.countFilled(sf::IntRect(startX, startY, endX - startX, endY - startY));
 
     return info;
 }
-*/
 
 sf::Vector2i Canvas::screenToTileIndex(const CanvasView& view, const sf::Vector2i& screenPos) const {
     sf::Vector2i canvasPos = view.screenToCanvas(screenPos);
     sf::Vector2f localPos = static_cast<sf::Vector2f>(canvasPos) - position;
-    int tileX = static_cast<int>(localPos.x) / tileSize;
-    int tileY = static_cast<int>(localPos.y) / tileSize;
+    // LoXOi̍Wjłׂ̃^Cw悤؂̂Ăŕϊ
+    int tileX = static_cast<int>(std::floor(localPos.x / tileSize));
+    int tileY = static_cast<int>(std::floor(localPos.y / tileSize));
     return sf::Vector2i(tileX, tileY);
 }
 
@@ -327,23 +1004,59 @@ bool Canvas::exportToImage(const std::string& filename,
     float spacing,
     float shrink) {
 
-    // o͗pRenderTexture쐬
-    sf::RenderTexture outputTexture;
-    if (!outputTexture.create(width * tileSize, height * tileSize)) {
-        std::cerr << "Error: Failed to create output texture for image export" << std::endl;
-        return false;
-    }
+    std::vector<PaletteSnapshot::Cells> cells;
+    PaletteSnapshot::packCells(patterns, cells);
+    return exportWithSoftwareRasterizer(filename, cells, colorPalettes, showGrid, spacing, shrink);
+}
+
+/**
+ * CPUX^CUŃLoX`悵ĕۑ
+ * GLReLXgeNX`̓ǂݖ߂gȂ߁AEBhEȂł삷
+ * PNG̓^Cs̃ohPʂŕ`悵Ȃ珑oAȊǑ`͑Ŝ`悵Ăۑ
+ */
+bool Canvas::exportWithSoftwareRasterizer(const std::string& filename,
+    const std::vector<PaletteSnapshot::Cells>& cells,
+    const std::vector<std::array<sf::Color, 3>>& colorSets,
+    bool showGrid,
+    float spacing,
+    float shrink) {
+
+    const unsigned imageWidth = static_cast<unsigned>(width * tileSize);
+    const unsigned imageHeight = static_cast<unsigned>(height * tileSize);
 
-    // LoXeo͗peNX`ɕ`
-    renderToOutputTexture(outputTexture, patterns, colorPalettes, showGrid, spacing, shrink);
+    // p^[Ƃ̃^C摜O
+    SoftwareRasterizer rasterizer(getAtlasSettings(spacing, shrink), showGrid, GRID_LINE_COLOR);
+    rasterizer.prepare(cells, colorSets);
 
-    // eNX`摜擾ĕۑ
-    sf::Image outputImage = outputTexture.getTexture().copyToImage();
+    std::string extension = filename.substr(filename.find_last_of('.') == std::string::npos ?
+        filename.size() : filename.find_last_of('.'));
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    bool saved = false;
+    if (extension == ".png") {
+        saved = exportPngStreaming(filename, rasterizer);
+    }
+    else {
+        // PNGȊOSFML̃GR[_[g߉摜Ŝɕ`
+        const std::size_t imageBytes = static_cast<std::size_t>(imageWidth) * imageHeight * 4;
+        if (imageBytes > FULL_IMAGE_MAX_BYTES) {
+            std::cerr << "Error: Image too large for " << extension << " export ("
+                << imageWidth << "x" << imageHeight << " pixels). Use .png instead." << std::endl;
+            return false;
+        }
+        std::vector<sf::Uint8> pixels(imageBytes);
+        rasterizer.renderTileRowsParallel(tiles, 0, height, pixels.data());
+
+        sf::Image outputImage;
+        outputImage.create(imageWidth, imageHeight, pixels.data());
+        saved = outputImage.saveToFile(filename);
+    }
 
     // t@Cۑ
-    if (outputImage.saveToFile(filename)) {
+    if (saved) {
         std::cout << "Image exported successfully: " << filename << std::endl;
-        std::cout << "Size: " << width * tileSize << "x" << height * tileSize << " pixels" << std::endl;
+        std::cout << "Size: " << imageWidth << "x" << imageHeight << " pixels" << std::endl;
         return true;
     }
     else {
@@ -352,125 +1065,33 @@ bool Canvas::exportToImage(const std::string& filename,
     }
 }
 
-
 /**
- * 摜o͗p̓`揈
- * renderToTexture()QlɁAo͐p̕`s
+ * PNG̃Xg[~Oo
+ * s[Ñ1ohiő STREAM_BAND_BYTES xj̃sNZobt@̂
  */
-
-
- // 摜o͗p̕`揈lɏC
-void Canvas::renderToOutputTexture(sf::RenderTexture& outputTexture,
-    const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<sf::Color, 3>>& colorPalettes,
-    bool showGrid,
-    float spacing,
-    float shrink,
-    float scale) {
-
-    // wiF̐ݒiύXȂj
-    outputTexture.clear(sf::Color::Transparent);
-
-    // XP[ϊKpiύXȂj
-    sf::View outputView;
-    if (scale != 1.0f) {
-        outputView.setSize(width * tileSize / scale, height * tileSize / scale);
-        outputView.setCenter((width * tileSize) / 2.0f, (height * tileSize) / 2.0f);
-        outputTexture.setView(outputView);
+bool Canvas::exportPngStreaming(const std::string& filename, const SoftwareRasterizer& rasterizer) {
+    const unsigned imageWidth = static_cast<unsigned>(width * tileSize);
+    const unsigned imageHeight = static_cast<unsigned>(height * tileSize);
+    const std::size_t tileRowBytes = static_cast<std::size_t>(imageWidth) * tileSize * 4;
+    const int bandTileRows = static_cast<int>(std::max<std::size_t>(1,
+        std::min<std::size_t>(height, STREAM_BAND_BYTES / tileRowBytes)));
+
+    PngStreamWriter writer;
+    if (!writer.open(filename, imageWidth, imageHeight)) {
+        return false;
     }
 
-    // Obh`iS̃Obh - ύXȂj
-    if (showGrid) {
-        sf::VertexArray lines(sf::Lines);
-        sf::Color gridLineColor = sf::Color(70, 70, 70);
-
-        for (int x = 0; x <= width; ++x) {
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, 0), gridLineColor));
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, height * tileSize), gridLineColor));
-        }
-
-        for (int y = 0; y <= height; ++y) {
-            lines.append(sf::Vertex(sf::Vector2f(0, y * tileSize), gridLineColor));
-            lines.append(sf::Vertex(sf::Vector2f(width * tileSize, y * tileSize), gridLineColor));
-        }
-
-        outputTexture.draw(lines);
-    }
-
-    // ===== ^C`i摜o͗pAj =====
-    float cellSize = tileSize / 3.0f;
-    sf::RectangleShape cell;
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int tileIndex = tiles[y][x];
-
-            if (tileIndex < 0) continue;
-            if (tileIndex >= patterns.size() || tileIndex >= colorPalettes.size()) continue;
-
-            const auto& pattern = patterns[tileIndex];
-            const auto& colorSet = colorPalettes[tileIndex];
-
-            // ^CEObh̕`iWbNj
-            if (useTileGridColor && spacing > 0.0f) {
-                // ^CŜObhFœhԂ
-                sf::RectangleShape tileBackground(sf::Vector2f(tileSize, tileSize));
-                tileBackground.setPosition(x * tileSize, y * tileSize);
-                tileBackground.setFillColor(tileGridColor);
-                outputTexture.draw(tileBackground);
-
-                // ̕`̈
-                float borderWidth = tileSize * spacing * 0.5f;
-                float innerTileSize = tileSize - (borderWidth * 2);
-                float innerCellSize = innerTileSize / 3.0f;
-
-                // 3x3p^[ɕ`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = innerCellSize * shrink;
-                                float cellCenterOffset = (innerCellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + borderWidth + cx * innerCellSize + cellCenterOffset,
-                                    y * tileSize + borderWidth + cy * innerCellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                outputTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
-            else {
-                // spacing = 0 ̏]`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = cellSize * shrink;
-                                float cellCenterOffset = (cellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + cx * cellSize + cellCenterOffset,
-                                    y * tileSize + cy * cellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                outputTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
+    std::vector<sf::Uint8> band(tileRowBytes * bandTileRows);
+    for (int row = 0; row < height; row += bandTileRows) {
+        int rowEnd = std::min(height, row + bandTileRows);
+        rasterizer.renderTileRowsParallel(tiles, row, rowEnd, band.data());
+        if (!writer.writeRows(band.data(), static_cast<unsigned>((rowEnd - row) * tileSize))) {
+            writer.finish();
+            return false;
         }
     }
 
-    outputTexture.display();
+    return writer.finish();
 }
 
 
@@ -479,363 +1100,107 @@ void Canvas::renderToOutputTexture(sf::RenderTexture& outputTexture,
 
 // ===== O[oJ[VXeΉ̐V\bh =====
 
-void Canvas::renderToTextureWithGlobalColors(const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<int, 3>>& globalColorIndices,
-    const std::array<sf::Color, 16>& globalColors,
-    bool showGrid, float spacing, float shrink) {
-
-    // wiF̐ݒ
-    renderTexture.clear(sf::Color(40, 40, 40));
-
-    // Obh`iS̃Obhj
-    if (showGrid) {
-        sf::VertexArray lines(sf::Lines);
-
-        // c
-        for (int x = 0; x <= width; ++x) {
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, 0), sf::Color(70, 70, 70)));
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, height * tileSize), sf::Color(70, 70, 70)));
-        }
-
-        // 
-        for (int y = 0; y <= height; ++y) {
-            lines.append(sf::Vertex(sf::Vector2f(0, y * tileSize), sf::Color(70, 70, 70)));
-            lines.append(sf::Vertex(sf::Vector2f(width * tileSize, y * tileSize), sf::Color(70, 70, 70)));
-        }
-
-        renderTexture.draw(lines);
-    }
-
-    // ^C`iO[oJ[gpj
-    float cellSize = tileSize / 3.0f;
-    sf::RectangleShape cell;
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int tileIndex = tiles[y][x];
-
-            // ȃ^C̏ꍇ̓XLbv
-            if (tileIndex < 0) continue;
-
-            // ͈̓`FbN
-            if (tileIndex >= patterns.size() || tileIndex >= globalColorIndices.size()) {
-                continue;
-            }
-
-            const auto& pattern = patterns[tileIndex];
-            const auto& colorIndices = globalColorIndices[tileIndex];
-
-            // O[oJ[pbgۂ̐F擾
-            std::array<sf::Color, 3> colorSet;
-            for (int i = 0; i < 3; ++i) {
-                int globalIndex = colorIndices[i];
-                if (globalIndex >= 0 && globalIndex < 16) {
-                    colorSet[i] = globalColors[globalIndex];
-                }
-                else {
-                    colorSet[i] = sf::Color::Black; // tH[obN
-                }
-            }
-
-            // ^CEObh̕`
-            if (useTileGridColor && spacing > 0.0f) {
-                // ^CŜ̗̈^CObhFœhԂ
-                sf::RectangleShape tileBackground(sf::Vector2f(tileSize, tileSize));
-                tileBackground.setPosition(x * tileSize, y * tileSize);
-                tileBackground.setFillColor(tileGridColor);
-                renderTexture.draw(tileBackground);
-
-                // ̕`̈vZ
-                float borderWidth = tileSize * spacing * 0.5f;
-                float innerTileSize = tileSize - (borderWidth * 2);
-                float innerCellSize = innerTileSize / 3.0f;
-
-                // 3x3p^[̗̈ɕ`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = innerCellSize * shrink;
-                                float cellCenterOffset = (innerCellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + borderWidth + cx * innerCellSize + cellCenterOffset,
-                                    y * tileSize + borderWidth + cy * innerCellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                renderTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
-            else {
-                // spacing = 0 ̏ꍇ͏]ʂ̕`
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = cellSize * shrink;
-                                float cellCenterOffset = (cellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + cx * cellSize + cellCenterOffset,
-                                    y * tileSize + cy * cellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                renderTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    renderTexture.display();
-}
-
 void Canvas::drawWithViewAndGlobalColors(sf::RenderWindow& window,
     const CanvasView& view,
-    const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<int, 3>>& globalColorIndices,
-    const std::array<sf::Color, 16>& globalColors,
+    const PaletteSnapshot& palette,
     bool showGrid,
     float spacing,
     float shrink) {
 
     if (!isInitialized) {
-        initializeRenderTexture();
+        initializeChunks();
     }
 
+    // 1:ݒύX`FbNiύX͑S`N𖳌j
+    applySettings(spacing, shrink);
 
-    /*
-    bool settingsChanged = (showGrid != lastShowGrid ||
-        spacing != lastSpacing ||
-        shrink != lastShrink);
-
-    if (isDirty || settingsChanged) {
-        renderToTextureWithGlobalColors(patterns, globalColorIndices, globalColors, showGrid, spacing, shrink);
-        isDirty = false;
-        lastShowGrid = showGrid;
-        lastSpacing = spacing;
-        lastShrink = shrink;
-    }
-    */
-
-    // 1:ݒύX`FbN̍œK
-    bool settingsChanged = false;
-    if (showGrid != lastShowGrid || spacing != lastSpacing || shrink != lastShrink) {
-        settingsChanged = true;
-        lastShowGrid = showGrid;
-        lastSpacing = spacing;
-        lastShrink = shrink;
+    // {ł͕\͈͂̃^Ĉݒڕ`i`NeNX`͕\ɖ߂ƂɍXVj
+    if (view.getZoom() >= DIRECT_ZOOM_THRESHOLD) {
+        drawDirect(window, view, palette, showGrid, spacing, shrink);
+        return;
     }
 
-    // 2: f[^ύX̌yʃ`FbN
-    bool dataChanged = false;
-    if (isDirty) {
-        dataChanged = true;
-    }
-    else {
-        // nbVlɂyʂȕύXm
-        size_t currentHash = calculateDataHash(patterns, globalColorIndices, globalColors);
-        if (currentHash != lastDataHash) {
-            dataChanged = true;
-            lastDataHash = currentHash;
+    // 2: o[Wԍ̔rŕύXmiύX̓AgXƍAYp^[̂ݍĐj
+    const PaletteVersions versions(palette);
+    const bool indexed = canUseIndexedRendering(palette.globalColors);
+    if (indexed) {
+        // CfbNX`ł̓O[oJ[̕ύX̓bNAbve[u̍XV̂
+        if (!hasPaletteVersions || versions.patterns != lastPaletteVersions.patterns ||
+            versions.colorIndices != lastPaletteVersions.colorIndices) {
+            paletteDirty = true;
         }
+        updateIndexedPalette(palette.globalColors);
+        encodeGlobalColorSets(palette.colorIndices, resolvedColorSets);
     }
-
-    // 3: Kvȏꍇ̂ݍĕ`
-    if (dataChanged || settingsChanged) {
-        renderToTextureWithGlobalColors(patterns, globalColorIndices, globalColors,
-            showGrid, spacing, shrink);
-        isDirty = false; // Zbg
+    else if (!hasPaletteVersions || versions != lastPaletteVersions) {
+        paletteDirty = true;
     }
+    lastPaletteVersions = versions;
+    hasPaletteVersions = true;
 
-    // `揈
-    if (isInitialized) {
-        sf::Sprite sprite(renderTexture.getTexture());
-        sprite.setPosition(position);
-
-        // CanvasView̕ϊKp
-        sf::RenderStates states;
-        states.transform = view.getTransform();
-
-        window.draw(sprite, states);
-
-        // E`
-        sf::RectangleShape border(sf::Vector2f(width * tileSize, height * tileSize));
-        border.setPosition(position);
-        border.setFillColor(sf::Color::Transparent);
-        border.setOutlineThickness(1.0f / view.getZoom());
-        border.setOutlineColor(sf::Color(100, 100, 100));
-        window.draw(border, states);
-    }
+    // 3: \͈͓ŕύX̂`N̂ݍĕ`悵ĕ\
+    // ʏ`ł̓XibvVbg̉ς݂̐F̂܂܎QƂ
+    drawChunked(window, view.getTransform(), view.getVisibleCanvasArea(), 1.0f / view.getZoom(),
+        palette.cells, indexed ? resolvedColorSets : palette.colors, showGrid, spacing, shrink, indexed, view.getZoom());
 }
 
-void Canvas::drawWithGlobalColors(sf::RenderWindow& window,
-    const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<int, 3>>& globalColorIndices,
-    const std::array<sf::Color, 16>& globalColors,
-    bool showGrid,
-    float spacing,
-    float shrink) {
+void Canvas::updateChunkCache(const PaletteSnapshot& palette, const sf::FloatRect& localArea,
+    float spacing, float shrink) {
 
     if (!isInitialized) {
-        initializeRenderTexture();
+        initializeChunks();
     }
+    applySettings(spacing, shrink);
 
-    bool settingsChanged = (showGrid != lastShowGrid ||
-        spacing != lastSpacing ||
-        shrink != lastShrink);
-
-    if (isDirty || settingsChanged) {
-        renderToTextureWithGlobalColors(patterns, globalColorIndices, globalColors, showGrid, spacing, shrink);
-        isDirty = false;
-        lastShowGrid = showGrid;
-        lastSpacing = spacing;
-        lastShrink = shrink;
+    if (chunksIndexed) {
+        chunksIndexed = false;
+        isDirty = true;
     }
 
-    if (isInitialized) {
-        sf::Sprite sprite(renderTexture.getTexture());
-        sprite.setPosition(position);
-        window.draw(sprite);
+    const PaletteVersions versions(palette);
+    if (!hasPaletteVersions || versions != lastPaletteVersions) {
+        paletteDirty = true;
+    }
+    lastPaletteVersions = versions;
+    hasPaletteVersions = true;
 
-        sf::RectangleShape border(sf::Vector2f(width * tileSize, height * tileSize));
-        border.setPosition(position);
-        border.setFillColor(sf::Color::Transparent);
-        border.setOutlineThickness(1);
-        border.setOutlineColor(sf::Color(100, 100, 100));
-        window.draw(border);
+    if (paletteDirty || isDirty || !patternAtlas.isReady()) {
+        updatePatternAtlas(palette.cells, palette.colors, spacing, shrink);
+    }
+    if (patternAtlas.isReady()) {
+        updateVisibleChunks(localArea);
     }
 }
 
-void Canvas::renderToOutputTextureWithGlobalColors(sf::RenderTexture& outputTexture,
+void Canvas::drawWithGlobalColors(sf::RenderWindow& window,
     const std::vector<std::vector<int>>& patterns,
     const std::vector<std::array<int, 3>>& globalColorIndices,
     const std::array<sf::Color, 16>& globalColors,
     bool showGrid,
     float spacing,
-    float shrink,
-    float scale) {
-
-    // wiF̐ݒ
-    outputTexture.clear(sf::Color::Transparent);
-
-    // XP[ϊKp
-    sf::View outputView;
-    if (scale != 1.0f) {
-        outputView.setSize(width * tileSize / scale, height * tileSize / scale);
-        outputView.setCenter((width * tileSize) / 2.0f, (height * tileSize) / 2.0f);
-        outputTexture.setView(outputView);
-    }
-
-    // Obh`iS̃Obhj
-    if (showGrid) {
-        sf::VertexArray lines(sf::Lines);
-        sf::Color gridLineColor = sf::Color(70, 70, 70);
-
-        for (int x = 0; x <= width; ++x) {
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, 0), gridLineColor));
-            lines.append(sf::Vertex(sf::Vector2f(x * tileSize, height * tileSize), gridLineColor));
-        }
-
-        for (int y = 0; y <= height; ++y) {
-            lines.append(sf::Vertex(sf::Vector2f(0, y * tileSize), gridLineColor));
-            lines.append(sf::Vertex(sf::Vector2f(width * tileSize, y * tileSize), gridLineColor));
-        }
+    float shrink) {
 
-        outputTexture.draw(lines);
+    if (!isInitialized) {
+        initializeChunks();
     }
 
-    // ^C`iO[oJ[gpj
-    float cellSize = tileSize / 3.0f;
-    sf::RectangleShape cell;
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int tileIndex = tiles[y][x];
+    applySettings(spacing, shrink);
+    paletteDirty = true;
 
-            if (tileIndex < 0) continue;
-            if (tileIndex >= patterns.size() || tileIndex >= globalColorIndices.size()) continue;
-
-            const auto& pattern = patterns[tileIndex];
-            const auto& colorIndices = globalColorIndices[tileIndex];
-
-            // O[oJ[pbgۂ̐F擾
-            std::array<sf::Color, 3> colorSet;
-            for (int i = 0; i < 3; ++i) {
-                int globalIndex = colorIndices[i];
-                if (globalIndex >= 0 && globalIndex < 16) {
-                    colorSet[i] = globalColors[globalIndex];
-                }
-                else {
-                    colorSet[i] = sf::Color::Black;
-                }
-            }
+    PaletteSnapshot::packCells(patterns, legacyPatternCells);
+    PaletteSnapshot::resolveColors(globalColorIndices, globalColors, resolvedColorSets);
+    sf::FloatRect wholeCanvas(position.x, position.y, width * tileSize, height * tileSize);
+    drawChunked(window, sf::Transform::Identity, wholeCanvas, 1.0f,
+        legacyPatternCells, resolvedColorSets, showGrid, spacing, shrink);
+}
 
-            // ^CEObh̕`iWbNj
-            if (useTileGridColor && spacing > 0.0f) {
-                sf::RectangleShape tileBackground(sf::Vector2f(tileSize, tileSize));
-                tileBackground.setPosition(x * tileSize, y * tileSize);
-                tileBackground.setFillColor(tileGridColor);
-                outputTexture.draw(tileBackground);
-
-                float borderWidth = tileSize * spacing * 0.5f;
-                float innerTileSize = tileSize - (borderWidth * 2);
-                float innerCellSize = innerTileSize / 3.0f;
-
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = innerCellSize * shrink;
-                                float cellCenterOffset = (innerCellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + borderWidth + cx * innerCellSize + cellCenterOffset,
-                                    y * tileSize + borderWidth + cy * innerCellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                outputTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
-            else {
-                if (pattern.size() >= 9) {
-                    for (int cy = 0; cy < 3; ++cy) {
-                        for (int cx = 0; cx < 3; ++cx) {
-                            int colorIndex = pattern[cy * 3 + cx];
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                float adjustedCellSize = cellSize * shrink;
-                                float cellCenterOffset = (cellSize - adjustedCellSize) * 0.5f;
-
-                                cell.setSize(sf::Vector2f(adjustedCellSize, adjustedCellSize));
-                                cell.setPosition(
-                                    x * tileSize + cx * cellSize + cellCenterOffset,
-                                    y * tileSize + cy * cellSize + cellCenterOffset
-                                );
-                                cell.setFillColor(colorSet[colorIndex]);
-                                outputTexture.draw(cell);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
+bool Canvas::exportToImageWithGlobalColors(const std::string& filename,
+    const PaletteSnapshot& palette,
+    bool showGrid,
+    float spacing,
+    float shrink) {
 
-    outputTexture.display();
+    return exportWithSoftwareRasterizer(filename, palette.cells, palette.colors, showGrid, spacing, shrink);
 }
 
 bool Canvas::exportToImageWithGlobalColors(const std::string& filename,
@@ -846,55 +1211,9 @@ bool Canvas::exportToImageWithGlobalColors(const std::string& filename,
     float spacing,
     float shrink) {
 
-    // o͗pRenderTexture쐬
-    sf::RenderTexture outputTexture;
-    if (!outputTexture.create(width * tileSize, height * tileSize)) {
-        std::cerr << "Error: Failed to create output texture for image export" << std::endl;
-        return false;
-    }
+    // \pobt@Ƃ͕ʂɃXibvVbg쐬i`撆̏ԂύXȂj
+    PaletteSnapshot palette;
+    palette.assign(patterns, globalColorIndices, globalColors);
 
-    // LoXeo͗peNX`ɕ`
-    renderToOutputTextureWithGlobalColors(outputTexture, patterns, globalColorIndices, globalColors, showGrid, spacing, shrink);
-
-    // eNX`摜擾ĕۑ
-    sf::Image outputImage = outputTexture.getTexture().copyToImage();
-
-    // t@Cۑ
-    if (outputImage.saveToFile(filename)) {
-        std::cout << "Image exported successfully: " << filename << std::endl;
-        std::cout << "Size: " << width * tileSize << "x" << height * tileSize << " pixels" << std::endl;
-        return true;
-    }
-    else {
-        std::cerr << "Error: Failed to save image: " << filename << std::endl;
-        return false;
-    }
+    return exportToImageWithGlobalColors(filename, palette, showGrid, spacing, shrink);
 }
-
-
-// nbVlvZ
-size_t Canvas::calculateDataHash(const std::vector<std::vector<int>>& patterns,
-    const std::vector<std::array<int, 3>>& globalColorIndices,
-    const std::array<sf::Color, 16>& globalColors) const {
-
-    size_t hash = 0;
-
-    // p^[̕ωm
-    hash ^= patterns.size() + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-
-    // ŏ̐p^[`FbNiŜ`FbNyʁj
-    size_t checkCount = std::min(patterns.size(), size_t(8));
-    for (size_t i = 0; i < checkCount; ++i) {
-        if (i < patterns.size() && !patterns[i].empty()) {
-            hash ^= patterns[i][0] + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-        }
-    }
-
-    // O[oJ[̍ŏ̐F`FbN
-    for (int i = 0; i < 4; ++i) {
-        hash ^= (globalColors[i].r + globalColors[i].g + globalColors[i].b)
-            + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-    }
-
-    return hash;
-}
\ No newline at end of file
@@ -2,46 +2,151 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <array>
+#include <memory>
+#include <cstdint>
+#include "PatternAtlas.hpp"
+#include "IndexedPalette.hpp"
+#include "PaletteSnapshot.hpp"
+#include "TileGrid.hpp"
 
 // O錾
 class CanvasView;
+class SoftwareRasterizer;
 
 class Canvas {
 private:
 	int width, height;
 	int tileSize;
 	sf::Vector2f position;
-	std::vector<std::vector<int>> tiles;
+	TileGrid tiles; // ^CzisD̘Aobt@A-1 = j
 
 	// ptH[}XœKp
 	bool isDirty = true;
 	bool isInitialized = false;
-	sf::RenderTexture renderTexture;
+
+	/**
+	 * LoX𕪊`P
+	 * 1RenderTexturełGPU̍őeNX`TCY𒴂邽߁A
+	 * ^C͈͂ƂɌʂ̃eNX`
+	 */
+	struct CanvasChunk {
+		sf::IntRect tileRect;                       // S^Ć͈iLoXS̊j
+		std::unique_ptr<sf::RenderTexture> texture; // `Nł͖m
+		bool needsFullRedraw = true;
+		std::vector<sf::IntRect> dirtyRects;        // ĕ`悪Kvȃ^C`
+		int filledTiles = 0;                        // zuς݃^C
+		uint64_t usedPatterns = 0;                  // ܂܂\̂p^[ibit i = p^[ ij
+
+		// k\p1/2𑜓xeNX`iFς݁Ak\̂݊mہj
+		std::unique_ptr<sf::RenderTexture> lodTexture;
+		bool lodNeedsFullRedraw = true;
+		std::vector<sf::IntRect> lodDirtyRects;     // LODւ̔fKvȃ^C`
+		uint64_t lodPaletteVersion = 0;             // CfbNX`掞AɎgF̃o[W
+		uint64_t lastVisibleFrame = 0;              // Ōɕ\͈͂ɓXV
+	};
+
+	static constexpr int CHUNK_MAX_TILES = 256;   // `N1ӂ̍ő^C
+	static constexpr int CHUNK_MAX_PIXELS = 2048; // `N1ӂ̍ősNZiVRAMߖj
+	// `NeNX`iLOD܂ށj̍v𒴂A\͈͊OŌÂ̂
+	static constexpr std::size_t CHUNK_TEXTURE_BUDGET_BYTES = std::size_t(512) * 1024 * 1024;
+
+	std::vector<CanvasChunk> chunks;
+	int chunkTiles = CHUNK_MAX_TILES;
+	int chunksX = 0, chunksY = 0;
+	bool tileCountsStale = true;
+	uint64_t chunkFrame = 0;                      // updateVisibleChunks ̌Ăяo
+	std::vector<int> releaseCandidates;           // ̃`Nԍiėpj
+
+	// `Nʂ̔wieNX`iwiF̂݁j
+	std::unique_ptr<sf::RenderTexture> emptyChunkTexture;
+	bool emptyChunkValid = false;
+
+	// `Np̏keNX`
+	std::unique_ptr<sf::RenderTexture> emptyChunkLodTexture;
+	bool emptyChunkLodValid = false;
+	uint64_t emptyChunkLodPaletteVersion = 0;
+
+	// ̔{̃Y[łLODi1/2𑜓xj\
+	static constexpr float LOD_ZOOM_THRESHOLD = 0.75f;
 
 	// O̕`ݒL^
-	bool lastShowGrid = false;
 	float lastSpacing = 0.0f;
 	float lastShrink = 0.0f;
 
-	void initializeRenderTexture();
-	void renderToTexture(const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<sf::Color, 3>>& colorPalettes,
-		bool showGrid, float spacing, float shrink);
+	void initializeChunks();
 
 	// ^CObhF̐ݒiVKǉj
 	sf::Color tileGridColor = sf::Color(128, 128, 128); // ftHgFԃO[
 	bool useTileGridColor = true; // ^CObhFgp邩
 
-	// ptH[}XP: Ōɕ`悵f[^̃nbVlۑ
-	mutable size_t lastDataHash = 0;
+
+	// ĕ`pF`N̕ύX`̏iOڋ`ɓj
+	static constexpr size_t MAX_DIRTY_RECTS = 64;
+
+	/**
+	 * ^CύXL^iאڂ`Ƃ͌j
+	 * @param x ^CXW
+	 * @param y ^CYW
+	 */
+	void markTileDirty(int x, int y) { markRectDirty(sf::IntRect(x, y, 1, 1)); }
+
+	/**
+	 * ύX`L^i1̃`NɎ܂`ł邱Ɓj
+	 */
+	void markRectDirty(const sf::IntRect& rect);
+
+	/**
+	 * ^C݁A`N̎gpƕύX`XV
+	 * @return lωꍇtrue
+	 */
+	bool writeTile(int x, int y, int tileIndex);
+
+	CanvasChunk& chunkAt(int x, int y) {
+		return chunks[(y / chunkTiles) * chunksX + (x / chunkTiles)];
+	}
+
+	// `ÑsNŹ͈iLoX[JWj
+	sf::FloatRect getChunkPixelRect(const CanvasChunk& chunk) const {
+		return sf::FloatRect(
+			static_cast<float>(chunk.tileRect.left * tileSize),
+			static_cast<float>(chunk.tileRect.top * tileSize),
+			static_cast<float>(chunk.tileRect.width * tileSize),
+			static_cast<float>(chunk.tileRect.height * tileSize));
+	}
+
+	void recountChunkTiles();
 
 public:
+	/**
+	 * pbg̃o[Wԍ̑g
+	 * TilePaletteip^[EO[oJ[CfbNXj
+	 * GlobalColorPaletteiFj̃JE^r邾ŕύXm
+	 */
+	struct PaletteVersions {
+		uint64_t patterns = 0;
+		uint64_t colorIndices = 0;
+		uint64_t colors = 0;
+
+		PaletteVersions() = default;
+		explicit PaletteVersions(const PaletteSnapshot& palette)
+			: patterns(palette.patternVersion), colorIndices(palette.colorIndexVersion), colors(palette.colorVersion) {}
+
+		bool operator!=(const PaletteVersions& other) const {
+			return patterns != other.patterns || colorIndices != other.colorIndices || colors != other.colors;
+		}
+	};
+
 	// f[^ύXOʒm郁\bh
-	void notifyDataChanged() { isDirty = true; }
+	// p^[EF̕ύX̓AgX̊YXbgƁAg`N̂ݍĕ`悳
+	void notifyDataChanged() { paletteDirty = true; }
 
-	Canvas(int width, int height, int tileSize, sf::Vector2f position)
-		: width(width), height(height), tileSize(tileSize), position(position) {
-		tiles.resize(height, std::vector<int>(width, -1));
+	/**
+	 * @param storage ^Cz̊i[iSparse ͕`ꂽ`N̂݃mہj
+	 */
+	Canvas(int width, int height, int tileSize, sf::Vector2f position,
+		TileGrid::Storage storage = TileGrid::Storage::Dense)
+		: width(width), height(height), tileSize(tileSize), position(position),
+		tiles(width, height, TileGrid::EMPTY, storage) {
 	}
 
 	// ===== ̃\bhiύXȂj =====
@@ -49,6 +154,7 @@ public:
 		if (position != pos) {
 			position = pos;
 			isDirty = true;
+			directGeometryValid = false;
 		}
 	}
 
@@ -62,17 +168,40 @@ public:
 		float spacing = 0.5f,
 		float shrink = 1.0f);
 
-	std::vector<std::vector<int>> getTileIndices() const {
+	/**
+	 * ^CzQƁiȂj
+	 * sEԒPʂ̓ǂݎ TileGrid::forEachRowSegment / readRow g
+	 */
+	const TileGrid& getTiles() const {
+		return tiles;
+	}
+
+	/**
+	 * ݂̃^Cz̃XibvVbg擾iO(1)ARs[ICgj
+	 * ȍ~̃LoXւ݂̏̓XibvVbgɉeA
+	 * ܂ꂽ`Nii[ł̓obt@Śj̎_ŕ
+	 */
+	TileGrid snapshotTiles() const {
 		return tiles;
 	}
 
-	void setTileIndices(const std::vector<std::vector<int>>& newTiles) {
-		if (newTiles.size() == height && newTiles[0].size() == width) {
-			tiles = newTiles;
-			isDirty = true;
-		}
+	/**
+	 * ^Czui[uŎ󂯎ATCYvꍇ̂݁j
+	 * @return uꍇtrue
+	 */
+	bool setTiles(TileGrid&& newTiles) {
+		if (newTiles.getHeight() != height || newTiles.getWidth() != width) return false;
+
+		newTiles.setStorage(tiles.getStorage()); // i[̓LoX̐ݒێ
+		tiles = std::move(newTiles);
+		isDirty = true;
+		tileCountsStale = true;
+		directGeometryValid = false;
+		return true;
 	}
 
+	TileGrid::Storage getTileStorage() const { return tiles.getStorage(); }
+
 	int getTileSize() const { return tileSize; }
 	sf::Vector2f getPosition() const { return position; }
 	int getWidth() const { return width; }
@@ -85,6 +214,20 @@ public:
 	void eraseTile(const sf::Vector2i& position);
 	void setTile(const sf::Vector2i& position, int tileIndex);
 
+	/**
+	 * ^CW1s̋ [x0, x1) 𓯂^CŖ߂i͈͊O͐؂l߂A-1ŏj
+	 * gpEύX`̓^CƂł͂Ȃ`NƂɂ܂Ƃ߂čXV
+	 * @return lω^C
+	 */
+	int fillTileSpan(int y, int x0, int x1, int tileIndex);
+
+	/**
+	 * ^CW1s [x0, x0 + count)  values ɏށi͈͊O͐؂l߂A-1ŏj
+	 * I͈͂̓\tEړpB`NƂɍs̋Ԃ܂Ƃ߂ď݁AlωԂύX`XV
+	 * @return lω^C
+	 */
+	int writeTileRow(int y, int x0, const TileGrid::Cell* values, int count);
+
 	// ===== CanvasViewΉ\bhi錾̂݁j =====
 	void drawWithView(sf::RenderWindow& window,
 		const CanvasView& view,
@@ -111,11 +254,15 @@ public:
 
 
 	// ===== V\bhFO[oJ[VXeΉ =====
+
+	/**
+	 * pbg̃XibvVbgQƂĕ\͈͂`
+	 * XibvVbg͓ǂނŕȂiύX̌m̓o[Wԍōsj
+	 * @param palette TilePalette::getSnapshot ̌
+	 */
 	void drawWithViewAndGlobalColors(sf::RenderWindow& window,
 		const CanvasView& view,
-		const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<int, 3>>& globalColorIndices,
-		const std::array<sf::Color, 16>& globalColors,
+		const PaletteSnapshot& palette,
 		bool showGrid = false,
 		float spacing = 0.5f,
 		float shrink = 1.0f);
@@ -128,6 +275,16 @@ public:
 		float spacing = 0.5f,
 		float shrink = 1.0f);
 
+	/**
+	 * pbg̃XibvVbgQƂĉ摜óiς݂̐F̂܂܎gpj
+	 * @param palette TilePalette::getSnapshot ̌
+	 */
+	bool exportToImageWithGlobalColors(const std::string& filename,
+		const PaletteSnapshot& palette,
+		bool showGrid = false,
+		float spacing = 0.5f,
+		float shrink = 1.0f);
+
 	bool exportToImageWithGlobalColors(const std::string& filename,
 		const std::vector<std::vector<int>>& patterns,
 		const std::vector<std::array<int, 3>>& globalColorIndices,
@@ -178,7 +335,10 @@ public:
 	*/
 	void setTileGridColor(const sf::Color& color) {
 		tileGridColor = color;
-		isDirty = true; // ĕ`tO
+		// CfbNXJ[`撆̓bNAbve[u̍XV݂̂Ŕf
+		if (!chunksIndexed) {
+			isDirty = true; // ĕ`tO
+		}
 	}
 
 	/**
@@ -207,55 +367,215 @@ public:
 		return useTileGridColor;
 	}
 
-private:
+	/**
+	 * 摜o͂Ɠ^C`ݒ擾ix`}[Nŏo͏ČꍇɎgpj
+	 */
+	PatternAtlas::Settings getAtlasSettings(float spacing, float shrink) const;
 
 	/**
-	* 摜o͗p̓
-	* @param outputTexture o͗pRenderTexture
-	* @param patterns p^[f[^
-	* @param colorPalettes J[pbgf[^
-	* @param showGrid Obh\邩
-	* @param spacing ObhԊu
-	* @param shrink ^Ck
-	* @param scale XP[{i1.0 = TCYj
-	*/
+	 * w͈͂̃`NeNX`ʂւ͕`ɍXVix`}[NŃLbVXVvꍇɎgpj
+	 * \ƓAgXXVA͈͓ŕύX̂`N̂ݍĕ`悷iύX`΂̂݁̕j
+	 * F͉ς݂̒ʏ`ŕ`iCfbNX`̓EBhE̕`ɔCj
+	 * @param palette TilePalette::getSnapshot ̌
+	 * @param localArea XV͈́iLoX[JWj
+	 */
+	void updateChunkCache(const PaletteSnapshot& palette, const sf::FloatRect& localArea,
+		float spacing = 0.5f, float shrink = 1.0f);
 
-	
-	void renderToOutputTexture(sf::RenderTexture& outputTexture,
-		const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<sf::Color, 3>>& colorPalettes,
-		bool showGrid,
-		float spacing,
-		float shrink,
-		float scale = 1.0f);
-	
+private:
 
 	/**
-   * XVꂽ`揈i^CObhFΉj
-   */
-	/*
-	void renderToTextureWithGridColor(const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<sf::Color, 3>>& colorPalettes,
+	 * CPUX^CUɂ摜o͂̋ʏ
+	 * @param cells p^[Ƃ3x3Z
+	 * @param colorSets p^[Ƃɉς݂3F
+	 */
+	bool exportWithSoftwareRasterizer(const std::string& filename,
+		const std::vector<PaletteSnapshot::Cells>& cells,
+		const std::vector<std::array<sf::Color, 3>>& colorSets,
 		bool showGrid, float spacing, float shrink);
-	*/
 
-	// VvCx[g\bhFO[oJ[Ή
-	void renderToTextureWithGlobalColors(const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<int, 3>>& globalColorIndices,
-		const std::array<sf::Color, 16>& globalColors,
+	// Xg[~Oo1oh̃sNZobt@
+	static constexpr std::size_t STREAM_BAND_BYTES = 32 * 1024 * 1024;
+	// PNGȊOi摜Ŝɕ`悷`jŏo͂łsNZobt@̏
+	static constexpr std::size_t FULL_IMAGE_MAX_BYTES = std::size_t(1024) * 1024 * 1024;
+
+	/**
+	 * ^Cs̃ohƂɕ`悵PNG֏o
+	 * @param rasterizer p^[ς݂̃X^CU
+	 */
+	bool exportPngStreaming(const std::string& filename, const SoftwareRasterizer& rasterizer);
+
+	// ===== ob`` =====
+
+	// `悲Ƃɍėp钸_zieʂێčĊmۂj
+	sf::VertexArray batchVertices;
+
+	// O[oJ[ʂ̍ėpobt@
+	std::vector<std::array<sf::Color, 3>> resolvedColorSets;
+
+	// `̉ϒp^[lߒėpobt@iXibvVbggȂ`Eo͗pj
+	std::vector<PaletteSnapshot::Cells> legacyPatternCells;
+
+	/**
+	 * w^C͈͂̃^C`
+	 * ^C̓AgX1̃eNX`tQuadƂĕ`悷
+	 * @param tileRect `悷^C͈
+	 * @param origin `eNX`ɑΉLoX[JW
+	 * @param atlas `Ɏgp^[AgX
+	 * @return `悵p^[̃rbg}XN
+	 */
+	uint64_t renderTileRegion(sf::RenderTarget& target, const sf::IntRect& tileRect,
+		const sf::Vector2f& origin, const PatternAtlas& atlas);
+
+	// ===== p^[AgX =====
+
+	PatternAtlas patternAtlas;
+	bool paletteDirty = true; // p^[EFς\
+	PaletteVersions lastPaletteVersions;
+	bool hasPaletteVersions = false;
+
+	/**
+	 * AgXXVAύXꂽp^[܂ރ`Nĕ`Ώۂɂ
+	 */
+	void updatePatternAtlas(const std::vector<PaletteSnapshot::Cells>& cells,
+		const std::vector<std::array<sf::Color, 3>>& colorSets,
+		float spacing, float shrink);
+
+	// ===== CfbNXJ[` =====
+
+	IndexedPalette indexedPalette;
+	bool indexedSupported = false; // VF[_[gp\i`掞ɔj
+	bool indexedChecked = false;
+	bool chunksIndexed = false;    // `NeNX`Xbgԍŕ`Ă邩
+
+	/**
+	 * CfbNXJ[`g邩
+	 * F͉nƂ̃uhʂe[uŕ\Ȃߒʏ̐F`g
+	 */
+	bool canUseIndexedRendering(const std::array<sf::Color, 16>& globalColors) const;
+
+	// bNAbve[u֌݂̐F𔽉f
+	void updateIndexedPalette(const std::array<sf::Color, 16>& globalColors);
+
+	// p^[Ƃ̃O[oJ[CfbNXXbgԍ̐Fɕϊ
+	static void encodeGlobalColorSets(const std::vector<std::array<int, 3>>& globalColorIndices,
+		std::vector<std::array<sf::Color, 3>>& colorSets);
+
+	// `NeNX`ɏޔwiFiCfbNX`掞̓Xbgԍj
+	sf::Color getChunkBackgroundColor() const;
+
+	// ===== `N` =====
+
+	// `NŜĕ`
+	void renderChunk(CanvasChunk& chunk);
+
+	/**
+	 * `NɋL^ς݂̕ύX`ĕ`
+	 * `RXg͕ύX^CɔႷ
+	 */
+	void renderChunkDirtyRegions(CanvasChunk& chunk);
+
+	const sf::Texture* getEmptyChunkTexture();
+
+	/**
+	 * \͈͓ŕύX̂`N̂ݍĕ`
+	 * \͈͊Õ`N͕ύXtOێ܂܌񂵂ɂ
+	 * @param localVisibleArea \͈́iLoX[JWj
+	 */
+	void updateVisibleChunks(const sf::FloatRect& localVisibleArea);
+
+	void drawVisibleChunks(sf::RenderTarget& target, const sf::RenderStates& states,
+		const sf::FloatRect& localVisibleArea, bool useLod);
+
+	/**
+	 * `NeNX`̍v CHUNK_TEXTURE_BUDGET_BYTES 𒴂ĂꍇA
+	 * \͈͊Õ`NŌɕ\ꂽÂ̂
+	 * `N͍Ăѕ\͈͂ɓ_őŜĕ`悷
+	 */
+	void releaseOffscreenChunkTextures(const sf::FloatRect& localVisibleArea);
+
+	// ===== LODik\j =====
+
+	/**
+	 * eNX`1/2ɏkďށi2x2sNZ̕ρj
+	 * @param region k̃sNŹ͈inullptȑꍇ͑Śj
+	 */
+	void downsampleTexture(sf::RenderTexture& source, sf::RenderTexture& target, const sf::FloatRect* region);
+
+	// LOD\peNX`̐FƈvĂ邩iCfbNX`掞͐F̕ύXŖɂȂj
+	bool isLodPaletteCurrent(uint64_t lodPaletteVersion) const;
+
+	/**
+	 * \͈͓̃`NLODXV
+	 * ύX`݂̂kAS̍ĕ`悳ꂽ`N͑Ŝk
+	 */
+	void updateVisibleChunkLods(const sf::FloatRect& localVisibleArea);
+
+	const sf::Texture* getEmptyChunkLodTexture();
+
+	// ===== ObhI[o[C =====
+
+	// LoXŜ̃ObhiLoXWLinesAϊ1ʃsNZj
+	sf::VertexArray gridOverlayVertices;
+	sf::Vector2i gridOverlaySize;       // ̃LoXTCYi^CPʁj
+	sf::Vector2f gridOverlayOrigin;     // ̃LoXʒu
+	int gridOverlayTileSize = 0;
+	int gridOverlayStep = 0;            // ̊Ԋui^CA0͖j
+
+	// Y[{ɉ̊Ԋuiʏŋl܂肷Ȃ悤2ׂ̂ŊԈj
+	int getGridOverlayStep(float zoom) const;
+
+	void buildGridOverlay(int step);
+
+	/**
+	 * ^C̏ɃObhd˂ĕ`
+	 * _̓LoX̑傫̊Ԋuςꍇ̂ݍĐA
+	 * \؂ւpł̓LbVeNX`E_ƂĐȂ
+	 */
+	void drawGridOverlay(sf::RenderTarget& target, const sf::RenderStates& states, float zoom);
+
+	// ===== {̒ڕ` =====
+
+	// ̔{ȏł͕\͈͂̃^Ĉ݂𒸓_zŒڕ`iʉ𑜓xŕ`悳֊sNj
+	static constexpr float DIRECT_ZOOM_THRESHOLD = 4.0f;
+	// p̂тɍč\zȂ悤A\͈͂̎͂ɗ]TĒ_𐶐
+	static constexpr int DIRECT_RANGE_MARGIN = 8;
+
+	sf::VertexArray directVertices;
+	sf::IntRect directTileRange;                   // _𐶐ς݂̃^C͈
+	bool directGeometryValid = false;
+	PaletteVersions directVersions;
+	PatternAtlas::Settings directSettings;
+
+	/**
+	 * \͈͂̃^C𒼐ڕ`
+	 * _͕\͈͂ςݔ͈͂OꂽꍇAf[^Eݒ肪ςꍇ̂ݍĐ
+	 * 1t[̃RXg͕\͈͂̃^CɔႵALoXŜ̑傫ɈˑȂ
+	 */
+	void drawDirect(sf::RenderWindow& window, const CanvasView& view,
+		const PaletteSnapshot& palette,
 		bool showGrid, float spacing, float shrink);
 
-	void renderToOutputTextureWithGlobalColors(sf::RenderTexture& outputTexture,
-		const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<int, 3>>& globalColorIndices,
-		const std::array<sf::Color, 16>& globalColors,
-		bool showGrid, float spacing, float shrink, float scale = 1.0f);
+	// w^C͈͂̔wiE^C̒_𐶐iZEF̓XibvVbg𒼐ڎQƁj
+	void buildDirectGeometry(const sf::IntRect& tileRange, const PaletteSnapshot& palette);
 
+	void drawBorder(sf::RenderTarget& target, const sf::RenderStates& states, float outlineThickness);
+
+	/**
+	 * \͈͂̃`NXVE`ƋE`܂Ƃ߂čs
+	 * @param visibleArea \͈́iCanvasView::getVisibleCanvasArea ƓWnj
+	 * @param indexed colorSets Xbgԍ̐FŁAVF[_[oRŕ\ꍇtrue
+	 * @param zoom \{iLOD_ZOOM_THRESHOLD łLOD\j
+	 */
+	void drawChunked(sf::RenderWindow& window, const sf::Transform& transform,
+		const sf::FloatRect& visibleArea, float outlineThickness,
+		const std::vector<PaletteSnapshot::Cells>& cells,
+		const std::vector<std::array<sf::Color, 3>>& colorSets,
+		bool showGrid, float spacing, float shrink, bool indexed = false, float zoom = 1.0f);
+
+	// `ݒ̕ύXmđS̖iύXtruej
+	bool applySettings(float spacing, float shrink);
 
 
-	// f[^̃nbVlvZiyʁj
-	size_t calculateDataHash(const std::vector<std::vector<int>>& patterns,
-		const std::vector<std::array<int, 3>>& globalColorIndices,
-		const std::array<sf::Color, 16>& globalColors) const;
 };
 
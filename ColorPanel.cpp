@@ -8,13 +8,33 @@
 ColorPanel::ColorPanel(const sf::Font& font) : font(font) {}
 
 void ColorPanel::setTarget(std::array<sf::Color, 3>& colorSet) {
-    currentColors = &colorSet;
+    if (currentColors != &colorSet) {
+        currentColors = &colorSet;
+        cacheValid = false;
+    }
 }
 
 void ColorPanel::draw(sf::RenderWindow& window) {
     if (!currentColors) return;
-    drawColorButtons(window);
-    drawSliders(window);
+
+    if (!cacheValid || cachedColors != *currentColors ||
+        cachedColorIndex != currentColorIndex || cachedPanelPos != panelPos) {
+        buildVertices();
+    }
+    window.draw(cachedVertices);
+    drawSliderLabels(window);
+}
+
+void ColorPanel::buildVertices() {
+    cachedVertices.setPrimitiveType(sf::Quads);
+    cachedVertices.clear();
+    appendColorButtons(cachedVertices);
+    appendSliders(cachedVertices);
+
+    cachedColors = *currentColors;
+    cachedColorIndex = currentColorIndex;
+    cachedPanelPos = panelPos;
+    cacheValid = true;
 }
 
 bool ColorPanel::handleEvent(const sf::Vector2i& mousePos, bool mousePressed, int& selectedColorIndex) {
@@ -99,40 +119,46 @@ std::array<sf::Color, 3> ColorPanel::getColorSet() const {
     return *currentColors;
 }
 
-void ColorPanel::drawColorButtons(sf::RenderWindow& window) {
-    /*
-    for (int i = 0; i < 3; ++i) {
-        sf::RectangleShape btn(sf::Vector2f(30, 30));
-        btn.setPosition(panelPos.x + i * 40, panelPos.y);
-        btn.setFillColor((*currentColors)[i]);
-        btn.setOutlineColor(currentColorIndex == i ? sf::Color::White : sf::Color(100, 100, 100));
-        btn.setOutlineThickness(2.f);
-        window.draw(btn);
-    }
-  */
+void ColorPanel::appendColorButtons(sf::VertexArray& vertices) {
     for (int i = 0; i < 4; ++i) { // 34ɕύX
-        sf::RectangleShape btn(sf::Vector2f(30, 30));
-        btn.setPosition(panelPos.x + i * 35, panelPos.y); // Ԋu4035ɒ
+        float x = panelPos.x + i * 35; // Ԋu4035ɒ
+        float y = panelPos.y;
 
         if (i == 3) {
             // 4ڂ̃{^FF
-            drawTransparentButton(window, panelPos.x + i * 35, panelPos.y);
+            appendTransparentButton(vertices, x, y);
         }
         else {
             // 1-3ڂ̃{^Fʏ̐F
-            btn.setFillColor((*currentColors)[i]);
-            window.draw(btn);
+            appendQuad(vertices, x, y, 30, 30, (*currentColors)[i]);
         }
 
-        // Ig̕`
-        btn.setFillColor(sf::Color::Transparent);
-        btn.setOutlineColor(currentColorIndex == i ? sf::Color::White : sf::Color(100, 100, 100));
-        btn.setOutlineThickness(2.f);
-        window.draw(btn);
+        // Ig
+        appendOutline(vertices, x, y, 30, 30, 2.f,
+            currentColorIndex == i ? sf::Color::White : sf::Color(100, 100, 100));
     }
 }
 
-void ColorPanel::drawSliders(sf::RenderWindow& window) {
+void ColorPanel::appendSliders(sf::VertexArray& vertices) {
+    // FI̓XC_[Ȃ
+    if (currentColorIndex == 3) return;
+
+    const sf::Color& col = (*currentColors)[currentColorIndex];
+    int values[3] = { col.r, col.g, col.b };
+
+    for (int i = 0; i < 3; ++i) {
+        float y = panelPos.y + 50 + i * 30;
+
+        // XC_[wi
+        appendQuad(vertices, panelPos.x, y, sliderSize.x, sliderSize.y, sf::Color(60, 60, 60));
+
+        // mu
+        appendQuad(vertices, panelPos.x + (values[i] / 255.f) * (sliderSize.x - 10), y,
+            10, sliderSize.y, sf::Color::White);
+    }
+}
+
+void ColorPanel::drawSliderLabels(sf::RenderWindow& window) {
 
     if (currentColorIndex == 3) {
         // FIFXC_[̑ɁuFveLXg\
@@ -150,18 +176,6 @@ void ColorPanel::drawSliders(sf::RenderWindow& window) {
     for (int i = 0; i < 3; ++i) {
         float y = panelPos.y + 50 + i * 30;
 
-        // XC_[wi
-        sf::RectangleShape bar(sliderSize);
-        bar.setPosition(panelPos.x, y);
-        bar.setFillColor(sf::Color(60, 60, 60));
-        window.draw(bar);
-
-        // mu
-        sf::RectangleShape knob({ 10, sliderSize.y });
-        knob.setPosition(panelPos.x + (values[i] / 255.f) * (sliderSize.x - 10), y);
-        knob.setFillColor(sf::Color::White);
-        window.draw(knob);
-
         // x
         std::stringstream ss;
         ss << labels[i] << ": " << values[i];
@@ -238,7 +252,7 @@ void ColorPanel::setCurrentSlotGlobalIndex(int globalIndex) {
     }
 }
 
-void ColorPanel::drawTransparentButton(sf::RenderWindow& window, float x, float y) {
+void ColorPanel::appendTransparentButton(sf::VertexArray& vertices, float x, float y) {
     const int checkSize = 6; // `FbJ[{[h1}X̃TCY
     sf::Color color1(240, 240, 240); // 邢O[
     sf::Color color2(200, 200, 200); // ÂO[
@@ -249,15 +263,10 @@ void ColorPanel::drawTransparentButton(sf::RenderWindow& window, float x, float
             // `FbJ[{[hp^[̐F
             sf::Color checkColor = ((cx / checkSize + cy / checkSize) % 2 == 0) ? color1 : color2;
 
-            // ȋ``
-            sf::RectangleShape check;
-            check.setSize(sf::Vector2f(
-                std::min(checkSize, 30 - cx),  // {^̋E𒴂Ȃ悤
-                std::min(checkSize, 30 - cy)
-            ));
-            check.setPosition(x + cx, y + cy);
-            check.setFillColor(checkColor);
-            window.draw(check);
+            // {^̋E𒴂Ȃ悤ȋ`
+            appendQuad(vertices, x + cx, y + cy,
+                static_cast<float>(std::min(checkSize, 30 - cx)),
+                static_cast<float>(std::min(checkSize, 30 - cy)), checkColor);
         }
     }
 }
\ No newline at end of file
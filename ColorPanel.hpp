@@ -77,9 +77,18 @@ private:
     std::array<int, 3> globalColorIndices = { 0, 1, 2 }; // ftHgFŏ3F
     GlobalColorPalette* globalColorPalette = nullptr; // O[oJ[pbgւ̎Q
 
-    void drawSliders(sf::RenderWindow& window);
-    void drawColorButtons(sf::RenderWindow& window);
+    // `LbViFEIXbgEʒuςꍇ̂ݒ_Đj
+    sf::VertexArray cachedVertices;
+    bool cacheValid = false;
+    std::array<sf::Color, 3> cachedColors;
+    int cachedColorIndex = -1;
+    sf::Vector2f cachedPanelPos;
+
+    void buildVertices();
+    void appendSliders(sf::VertexArray& vertices);
+    void appendColorButtons(sf::VertexArray& vertices);
+    void drawSliderLabels(sf::RenderWindow& window);
 
     //ǉFߐF
-    void drawTransparentButton(sf::RenderWindow& window, float x, float y);
+    void appendTransparentButton(sf::VertexArray& vertices, float x, float y);
 };
\ No newline at end of file
@@ -101,13 +101,31 @@ void DrawingManager::drawPreview(sf::RenderWindow& window,
     const sf::Vector2i& currentMousePos,
     const CanvasView& view,
     int brushSize) const {
+    DrawingTool* tool = toolManager.getCurrentTool();
+    if (!tool) return;
+
     // `撆ړ̏ꍇ̂݃vr[\
     if (isDrawing && hasMoved) {
-        DrawingTool* tool = toolManager.getCurrentTool();
-        if (tool) {
-            tool->drawPreview(window, mouseDownPos, currentMousePos, view, brushSize);
-        }
+        tool->drawPreview(window, mouseDownPos, currentMousePos, view, brushSize);
     }
+    else if (tool->hasPersistentPreview()) {
+        tool->drawPreview(window, isDrawing ? mouseDownPos : currentMousePos, currentMousePos, view, brushSize);
+    }
+}
+
+/**
+ * L[݂͂̃c[֓n
+ * hbO̓c[̏Ԃr̂ߓnȂ
+ */
+bool DrawingManager::handleKeyPressed(const sf::Event::KeyEvent& key,
+    const sf::Vector2i& mousePos,
+    Canvas& canvas,
+    const CanvasView& view,
+    int patternIndex) {
+    if (isDrawing) return false;
+
+    DrawingTool* tool = toolManager.getCurrentTool();
+    return tool && tool->onKeyPressed(key, mousePos, canvas, view, patternIndex);
 }
 
 /**
@@ -136,6 +136,66 @@ public:
         return toolManager.getCurrentToolName();
     }
 
+    /**
+     * uV`ilpEہjݒE擾
+     */
+    void setBrushShape(BrushMask::Shape shape) {
+        toolManager.setBrushShape(shape);
+    }
+
+    BrushMask::Shape getBrushShape() const {
+        return toolManager.getBrushShape();
+    }
+
+    /**
+     * }`c[i~Eȉ~j̓hԂ[hݒE擾
+     */
+    void setShapeFilled(bool value) {
+        toolManager.setShapeFilled(value);
+    }
+
+    bool isShapeFilled() const {
+        return toolManager.isShapeFilled();
+    }
+
+    /**
+     * hԂc[̐ݒi8ߖTAES̒uj
+     */
+    void setFillOptions(bool eightConnected, bool replaceAll) {
+        toolManager.setFillOptions(eightConnected, replaceAll);
+    }
+
+    bool isFillEightConnected() const {
+        return toolManager.isFillEightConnected();
+    }
+
+    bool isFillReplaceAll() const {
+        return toolManager.isFillReplaceAll();
+    }
+
+    /**
+     * L[݂͂̃c[֓niIc[̃Rs[E\tj
+     * @param key L[Cxg
+     * @param mousePos }EXʒuiXN[Wj
+     * @param canvas `ΏۃLoX
+     * @param view CanvasViewCX^X
+     * @param patternIndex Iꂽp^[CfbNX
+     * @return c[L[ꍇtrue
+     */
+    bool handleKeyPressed(const sf::Event::KeyEvent& key,
+        const sf::Vector2i& mousePos,
+        Canvas& canvas,
+        const CanvasView& view,
+        int patternIndex);
+
+    /**
+     * hbOȊOvr[\c[iI͈̘͂gȂǁj
+     */
+    bool hasPersistentPreview() const {
+        DrawingTool* tool = toolManager.getCurrentTool();
+        return tool && tool->hasPersistentPreview();
+    }
+
     // ===== `E\֘A =====
 
     /**
@@ -155,7 +215,7 @@ public:
 
     /**
      * vr[`
-     * c[ŃhbÕvr[\
+     * c[ŃhbÕvr[\iIc[͏ɑI͈͂\j
      * @param window `EBhE
      * @param currentMousePos ݂̃}EXʒuiXN[Wj
      * @param view CanvasViewCX^X
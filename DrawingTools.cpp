@@ -4,6 +4,7 @@
 #include "CanvasView.hpp"
 #include <cmath>
 #include <algorithm>
+#include <climits>
 #include "LargeTileSystem.hpp"
 
 // ===== DrawingTool 基底クラスのヘルパー実装 =====
@@ -17,69 +18,182 @@ void DrawingTool::applyBrushAt(const sf::Vector2i& position,
 	Canvas& canvas,
 	const CanvasView& view,
 	int patternIndex) const {
+	stampBrush(canvas.screenToTileIndex(view, position), brushSize, canvas, patternIndex);
+}
 
-	std::set<std::pair<int, int>> processedPositions;
-	int start = -(brushSize - 1) / 2;  // ブラシ範囲の開始オフセット
-	int end = brushSize / 2;           // ブラシ範囲の終了オフセット
-
-	// ブラシサイズ分の範囲でタイルを処理
-	for (int dy = start; dy <= end; ++dy) {
-		for (int dx = start; dx <= end; ++dx) {
-			// ブラシの各点でのスクリーン座標を計算
-			sf::Vector2i targetScreen(
-				position.x + dx * static_cast<int>(canvas.getTileSize() * view.getZoom()),
-				position.y + dy * static_cast<int>(canvas.getTileSize() * view.getZoom())
-			);
-
-			// キャンバス内かチェック
-			if (canvas.containsInView(view, targetScreen)) {
-				// タイルインデックスを取得して重複処理を避ける
-				sf::Vector2i tileIndex = canvas.screenToTileIndex(view, targetScreen);
-
-				std::pair<int, int> tilePos = { tileIndex.x, tileIndex.y };
-				if (processedPositions.find(tilePos) == processedPositions.end()) {
-					processedPositions.insert(tilePos);
-
-					// パターンインデックスに応じて描画または消去
-					if (patternIndex >= 0) {
-						canvas.handleClickInView(view, targetScreen, patternIndex);
-					}
-					else {
-						canvas.eraseTileInView(view, targetScreen);
-					}
-				}
-			}
+/**
+ * ブラシマスクの各行を区間として書き込む
+ * マスクは事前生成済みのため、適用ごとのメモリ確保・重複判定は不要
+ */
+void DrawingTool::stampBrush(const sf::Vector2i& centerTile,
+	int brushSize,
+	Canvas& canvas,
+	int patternIndex) const {
+
+	const BrushMask& mask = BrushMask::get(brushShape, brushSize);
+	for (const BrushMask::RowSpan& span : mask) {
+		canvas.fillTileSpan(centerTile.y + span.dy,
+			centerTile.x + span.x0, centerTile.x + span.x1, patternIndex);
+	}
+}
+
+/**
+ * ブラシを線分に沿って掃引
+ * 凸形状のブラシを線分に沿って動かした範囲は各行で1つの区間になるため、
+ * 行ごとの [最小, 最大] だけを記録し、最後に1行1回書き込む
+ */
+void DrawingTool::stampBrushLine(const sf::Vector2i& startTile,
+	const sf::Vector2i& endTile,
+	int brushSize,
+	Canvas& canvas,
+	int patternIndex) const {
+
+	const BrushMask& mask = BrushMask::get(brushShape, brushSize);
+	if (mask.getRowCount() == 0) return;
+
+	// 掃引範囲の行（キャンバス外の行は記録しない）
+	const int top = std::max(0, std::min(startTile.y, endTile.y) + mask.begin()->dy);
+	const int bottom = std::min(canvas.getHeight() - 1, std::max(startTile.y, endTile.y) + (mask.end() - 1)->dy);
+	if (bottom < top) return;
+
+	const std::size_t rowCount = static_cast<std::size_t>(bottom - top + 1);
+	sweepLeft.assign(rowCount, INT_MAX);
+	sweepRight.assign(rowCount, INT_MIN);
+
+	// Bresenhamでブラシ中心をタイル単位に進める
+	int x = startTile.x, y = startTile.y;
+	const int dx = std::abs(endTile.x - startTile.x);
+	const int dy = -std::abs(endTile.y - startTile.y);
+	const int stepX = startTile.x < endTile.x ? 1 : -1;
+	const int stepY = startTile.y < endTile.y ? 1 : -1;
+	int error = dx + dy;
+
+	while (true) {
+		for (const BrushMask::RowSpan& span : mask) {
+			const int row = y + span.dy - top;
+			if (row < 0 || row >= static_cast<int>(rowCount)) continue;
+			sweepLeft[row] = std::min(sweepLeft[row], x + span.x0);
+			sweepRight[row] = std::max(sweepRight[row], x + span.x1);
+		}
+
+		if (x == endTile.x && y == endTile.y) break;
+		const int doubledError = error * 2;
+		if (doubledError >= dy) {
+			error += dy;
+			x += stepX;
+		}
+		if (doubledError <= dx) {
+			error += dx;
+			y += stepY;
+		}
+	}
+
+	for (std::size_t row = 0; row < rowCount; ++row) {
+		if (sweepLeft[row] < sweepRight[row]) {
+			canvas.fillTileSpan(top + static_cast<int>(row), sweepLeft[row], sweepRight[row], patternIndex);
 		}
 	}
 }
 
 /**
- * 線に沿ってブラシを適用するヘルパー関数
- * 開始点から終了点までの直線上にブラシを適用
+ * 楕円を行単位で書き込む
+ * 輪郭は各行の左右端から上下の行の端までの区間（8近傍でつながる）をブラシマスクで広げ、
+ * 行ごとに左右の帯の [最小, 最大] にまとめる。帯が重なる行と塗りつぶし時は1区間にする
  */
-void DrawingTool::applyBrushAlongLine(const sf::Vector2i& startPos,
-	const sf::Vector2i& endPos,
+void DrawingTool::stampEllipse(const sf::IntRect& bounds,
+	bool fill,
 	int brushSize,
 	Canvas& canvas,
-	const CanvasView& view,
 	int patternIndex) const {
 
-	// 線分の長さを計算
-	int dx = std::abs(endPos.x - startPos.x);
-	int dy = std::abs(endPos.y - startPos.y);
-	int steps = std::max(dx, dy);
-	if (steps == 0) steps = 1;
+	if (bounds.width <= 0 || bounds.height <= 0) return;
+	const BrushMask& mask = BrushMask::get(brushShape, brushSize);
+	if (mask.getRowCount() == 0) return;
+
+	// 楕円の各行の範囲 [sweepLeft, sweepRight)（タイル中心が楕円内にあるタイル）
+	const int ellipseRows = bounds.height;
+	const double centerX = bounds.left + (bounds.width - 1) * 0.5;
+	const double centerY = bounds.top + (bounds.height - 1) * 0.5;
+	const double radiusX = bounds.width * 0.5;
+	const double radiusY = bounds.height * 0.5;
+	sweepLeft.resize(ellipseRows);
+	sweepRight.resize(ellipseRows);
+	for (int i = 0; i < ellipseRows; ++i) {
+		const double t = (bounds.top + i - centerY) / radiusY;
+		const double half = radiusX * std::sqrt(std::max(0.0, 1.0 - t * t));
+		int left = static_cast<int>(std::ceil(centerX - half));
+		int right = static_cast<int>(std::floor(centerX + half));
+		if (left > right) {
+			// 範囲がタイル中心に届かない行は中央のタイルを使用
+			left = static_cast<int>(std::floor(centerX));
+			right = static_cast<int>(std::ceil(centerX));
+		}
+		sweepLeft[i] = left;
+		sweepRight[i] = right + 1;
+	}
 
-	// 線分を等間隔でサンプリングしてブラシを適用
-	for (int i = 0; i <= steps; ++i) {
-		float t = static_cast<float>(i) / steps;  // 補間パラメータ（0.0〜1.0）
+	// 出力する行（ブラシの広がりを含み、キャンバス外の行は記録しない）
+	const int top = std::max(0, bounds.top + mask.begin()->dy);
+	const int bottom = std::min(canvas.getHeight() - 1, bounds.top + ellipseRows - 1 + (mask.end() - 1)->dy);
+	if (bottom < top) return;
+	const int rowCount = bottom - top + 1;
+	shapeBands.assign(rowCount, RowBands{ INT_MAX, INT_MIN, INT_MAX, INT_MIN });
+
+	for (int i = 0; i < ellipseRows; ++i) {
+		const int y = bounds.top + i;
+		const int left = sweepLeft[i], right = sweepRight[i];
+
+		// 輪郭の左右の区間（上下端の行は行全体）
+		int leftEnd = right, rightStart = left;
+		if (i > 0 && i < ellipseRows - 1) {
+			leftEnd = std::max(left + 1, std::max(sweepLeft[i - 1], sweepLeft[i + 1]));
+			rightStart = std::min(right - 1, std::min(sweepRight[i - 1], sweepRight[i + 1]));
+		}
 
-		// 線形補間で現在の位置を計算
-		int ix = static_cast<int>(startPos.x + t * (endPos.x - startPos.x));
-		int iy = static_cast<int>(startPos.y + t * (endPos.y - startPos.y));
+		for (const BrushMask::RowSpan& span : mask) {
+			const int row = y + span.dy - top;
+			if (row < 0 || row >= rowCount) continue;
+			RowBands& bands = shapeBands[row];
+			bands.leftMin = std::min(bands.leftMin, left + span.x0);
+			bands.leftMax = std::max(bands.leftMax, leftEnd + span.x1 - 1);
+			bands.rightMin = std::min(bands.rightMin, rightStart + span.x0);
+			bands.rightMax = std::max(bands.rightMax, right + span.x1 - 1);
+		}
 
-		applyBrushAt(sf::Vector2i(ix, iy), brushSize, canvas, view, patternIndex);
+		if (fill && y >= top && y <= bottom) {
+			RowBands& bands = shapeBands[y - top];
+			bands.leftMin = std::min(bands.leftMin, left);
+			bands.rightMax = std::max(bands.rightMax, right);
+		}
 	}
+
+	for (int row = 0; row < rowCount; ++row) {
+		const RowBands& bands = shapeBands[row];
+		if (bands.leftMin >= bands.leftMax) continue;
+
+		const int y = top + row;
+		if (fill || bands.leftMax >= bands.rightMin) {
+			canvas.fillTileSpan(y, std::min(bands.leftMin, bands.rightMin), std::max(bands.leftMax, bands.rightMax), patternIndex);
+		}
+		else {
+			canvas.fillTileSpan(y, bands.leftMin, bands.leftMax, patternIndex);
+			canvas.fillTileSpan(y, bands.rightMin, bands.rightMax, patternIndex);
+		}
+	}
+}
+
+/**
+ * 線に沿ってブラシを適用するヘルパー関数
+ * 開始点から終了点までの直線上にブラシを適用
+ */
+void DrawingTool::applyBrushAlongLine(const sf::Vector2i& startPos,
+	const sf::Vector2i& endPos,
+	int brushSize,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex) const {
+	stampBrushLine(canvas.screenToTileIndex(view, startPos), canvas.screenToTileIndex(view, endPos),
+		brushSize, canvas, patternIndex);
 }
 
 /**
@@ -94,17 +208,27 @@ void DrawingTool::drawBasicCursor(sf::RenderWindow& window,
 	const sf::Color& color) const {
 
 	float zoom = view.getZoom();
-	float cursorRadius = (brushSize * tileSize * zoom) / 2.0f;
-
-	// カーソル円を描画
-	sf::CircleShape cursor(cursorRadius);
-	cursor.setOrigin(cursorRadius, cursorRadius);
-	cursor.setPosition(static_cast<sf::Vector2f>(mousePos));
-	cursor.setFillColor(color);
-	cursor.setOutlineThickness(1.0f);
-	cursor.setOutlineColor(sf::Color(255, 255, 255, 150));
-
-	window.draw(cursor);
+	float cursorRadius = (BrushMask::clampSize(brushSize) * tileSize * zoom) / 2.0f;
+
+	// カーソルを描画（ブラシ形状に合わせて円または四角）
+	if (brushShape == BrushMask::Shape::Round) {
+		sf::CircleShape cursor(cursorRadius);
+		cursor.setOrigin(cursorRadius, cursorRadius);
+		cursor.setPosition(static_cast<sf::Vector2f>(mousePos));
+		cursor.setFillColor(color);
+		cursor.setOutlineThickness(1.0f);
+		cursor.setOutlineColor(sf::Color(255, 255, 255, 150));
+		window.draw(cursor);
+	}
+	else {
+		sf::RectangleShape cursor(sf::Vector2f(cursorRadius * 2.0f, cursorRadius * 2.0f));
+		cursor.setOrigin(cursorRadius, cursorRadius);
+		cursor.setPosition(static_cast<sf::Vector2f>(mousePos));
+		cursor.setFillColor(color);
+		cursor.setOutlineThickness(1.0f);
+		cursor.setOutlineColor(sf::Color(255, 255, 255, 150));
+		window.draw(cursor);
+	}
 
 	// 高ズーム時は中心点を表示
 	if (zoom > 2.0f) {
@@ -414,14 +538,13 @@ void CircleTool::onDrawEnd(const sf::Vector2i& endPos,
 		(endPos.y - startPos.y) * (endPos.y - startPos.y)
 		));
 
-	// 半径が小さすぎる場合は点を描画
-	if (radius < 3.0f) {
-		applyBrushAt(startPos, brushSize, canvas, view, patternIndex);
-	}
-	else {
-		// 円を描画
-		drawCircle(startPos, radius, brushSize, canvas, view, patternIndex);
-	}
+	// 中心と半径をタイル単位に変換し、中心タイルを含む奇数幅の外接矩形に内接する円を描画
+	// （半径が1タイル未満の場合は中心のみ）
+	sf::Vector2i centerTile = canvas.screenToTileIndex(view, startPos);
+	int radiusTiles = static_cast<int>(std::round(radius / (canvas.getTileSize() * view.getZoom())));
+	sf::IntRect bounds(centerTile.x - radiusTiles, centerTile.y - radiusTiles,
+		radiusTiles * 2 + 1, radiusTiles * 2 + 1);
+	stampEllipse(bounds, filled, brushSize, canvas, patternIndex);
 }
 
 /**
@@ -444,7 +567,7 @@ void CircleTool::drawPreview(sf::RenderWindow& window,
 	sf::CircleShape previewCircle(radius);
 	previewCircle.setOrigin(radius, radius);
 	previewCircle.setPosition(static_cast<sf::Vector2f>(startPos));
-	previewCircle.setFillColor(sf::Color::Transparent);
+	previewCircle.setFillColor(filled ? sf::Color(255, 255, 255, 40) : sf::Color::Transparent);
 	previewCircle.setOutlineThickness(2.0f);
 	previewCircle.setOutlineColor(sf::Color(255, 255, 255, 150));
 	window.draw(previewCircle);
@@ -528,62 +651,6 @@ void CircleTool::drawCursor(sf::RenderWindow& window,
 	window.draw(indicator);
 }
 
-/**
- * 円周上の点を計算してブラシを適用
- * ブレゼンハムの円描画アルゴリズムを使用
- */
-void CircleTool::drawCircle(const sf::Vector2i& centerPos,
-	float radius,
-	int brushSize,
-	Canvas& canvas,
-	const CanvasView& view,
-	int patternIndex) const {
-
-	int r = static_cast<int>(radius);
-	int x = 0;
-	int y = r;
-	int d = 3 - 2 * r;
-
-	// 8方向対称性を利用した円描画
-	auto plotCirclePoints = [&](int x, int y) {
-		// 8つの対称点にブラシを適用
-		std::vector<sf::Vector2i> points = {
-			sf::Vector2i(centerPos.x + x, centerPos.y + y),
-			sf::Vector2i(centerPos.x - x, centerPos.y + y),
-			sf::Vector2i(centerPos.x + x, centerPos.y - y),
-			sf::Vector2i(centerPos.x - x, centerPos.y - y),
-			sf::Vector2i(centerPos.x + y, centerPos.y + x),
-			sf::Vector2i(centerPos.x - y, centerPos.y + x),
-			sf::Vector2i(centerPos.x + y, centerPos.y - x),
-			sf::Vector2i(centerPos.x - y, centerPos.y - x)
-		};
-
-		for (const auto& point : points) {
-			if (canvas.containsInView(view, point)) {
-				applyBrushAt(point, brushSize, canvas, view, patternIndex);
-			}
-		}
-		};
-
-	// 初期点を描画
-	plotCirclePoints(x, y);
-
-	// ブレゼンハムアルゴリズム
-	while (y >= x) {
-		x++;
-
-		if (d > 0) {
-			y--;
-			d = d + 4 * (x - y) + 10;
-		}
-		else {
-			d = d + 4 * x + 6;
-		}
-
-		plotCirclePoints(x, y);
-	}
-}
-
 // ===== EllipseTool 実装 =====
 
 /**
@@ -623,27 +690,13 @@ void EllipseTool::onDrawEnd(const sf::Vector2i& endPos,
 	int patternIndex,
 	int brushSize) {
 
-	// 矩形が小さすぎる場合は点を描画
-	int width = std::abs(endPos.x - startPos.x);
-	int height = std::abs(endPos.y - startPos.y);
-
-	if (width < 3 && height < 3) {
-		applyBrushAt(startPos, brushSize, canvas, view, patternIndex);
-	}
-	else {
-		// 左上角と右下角を正規化
-		sf::Vector2i topLeft(
-			std::min(startPos.x, endPos.x),
-			std::min(startPos.y, endPos.y)
-		);
-		sf::Vector2i bottomRight(
-			std::max(startPos.x, endPos.x),
-			std::max(startPos.y, endPos.y)
-		);
-
-		// 楕円を描画
-		drawEllipse(topLeft, bottomRight, brushSize, canvas, view, patternIndex);
-	}
+	// 開始・終了位置のタイルを対角とする矩形（両端のタイルを含む）に内接する楕円を描画
+	// （同じタイルの場合は1タイルのみ）
+	sf::Vector2i startTile = canvas.screenToTileIndex(view, startPos);
+	sf::Vector2i endTile = canvas.screenToTileIndex(view, endPos);
+	sf::IntRect bounds(std::min(startTile.x, endTile.x), std::min(startTile.y, endTile.y),
+		std::abs(endTile.x - startTile.x) + 1, std::abs(endTile.y - startTile.y) + 1);
+	stampEllipse(bounds, filled, brushSize, canvas, patternIndex);
 }
 
 /**
@@ -682,7 +735,7 @@ void EllipseTool::drawPreview(sf::RenderWindow& window,
 		float scaleY = params.radiusY / maxRadius;
 		previewEllipse.setScale(scaleX, scaleY);
 
-		previewEllipse.setFillColor(sf::Color::Transparent);
+		previewEllipse.setFillColor(filled ? sf::Color(255, 255, 255, 40) : sf::Color::Transparent);
 		previewEllipse.setOutlineThickness(2.0f / std::min(scaleX, scaleY)); // スケールに応じて調整
 		previewEllipse.setOutlineColor(sf::Color(255, 255, 255, 150));
 		window.draw(previewEllipse);
@@ -792,98 +845,466 @@ EllipseTool::EllipseParams EllipseTool::calculateEllipseParams(const sf::Vector2
 	return params;
 }
 
+// ===== FillTool 実装 =====
+
 /**
- * 楕円の境界線を描画
- * 中点楕円アルゴリズムを使用
+ * 塗りつぶしツール：描画開始
+ * クリックしたタイルを起点に塗りつぶす（置き換えモードではキャンバス全体の同じタイル）
  */
-void EllipseTool::drawEllipse(const sf::Vector2i& topLeft,
-	const sf::Vector2i& bottomRight,
-	int brushSize,
+void FillTool::onDrawStart(const sf::Vector2i& startPos,
 	Canvas& canvas,
 	const CanvasView& view,
-	int patternIndex) const {
+	int patternIndex,
+	int brushSize) {
 
-	EllipseParams params = calculateEllipseParams(topLeft, bottomRight);
+	sf::Vector2i tile = canvas.screenToTileIndex(view, startPos);
+	const TileGrid& tiles = canvas.getTiles();
+	if (!tiles.contains(tile.x, tile.y)) return;
+
+	if (replaceAll) {
+		replaceAllMatching(canvas, tiles.get(tile.x, tile.y), patternIndex);
+	}
+	else {
+		floodFill(canvas, tile.x, tile.y, patternIndex);
+	}
+}
+
+/**
+ * 塗りつぶしツール：描画継続
+ * 連続描画ではないので何もしない
+ */
+void FillTool::onDrawContinue(const sf::Vector2i& currentPos,
+	const sf::Vector2i& lastPos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex,
+	int brushSize) {
+	// 塗りつぶしはクリック時のみ
+}
+
+/**
+ * 塗りつぶしツール：描画終了
+ * 開始時に塗りつぶし済みのため何もしない
+ */
+void FillTool::onDrawEnd(const sf::Vector2i& endPos,
+	const sf::Vector2i& startPos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex,
+	int brushSize) {
+	// 塗りつぶしはクリック時のみ
+}
+
+/**
+ * 塗りつぶしツール：プレビュー描画
+ * プレビューは表示しない
+ */
+void FillTool::drawPreview(sf::RenderWindow& window,
+	const sf::Vector2i& startPos,
+	const sf::Vector2i& currentPos,
+	const CanvasView& view,
+	int brushSize) const {
+	// 塗りつぶしはクリック時に確定するためプレビューは不要
+}
+
+/**
+ * 塗りつぶしツール：カーソル描画
+ * 1タイル分の水色カーソル
+ */
+void FillTool::drawCursor(sf::RenderWindow& window,
+	const sf::Vector2i& mousePos,
+	const CanvasView& view,
+	int brushSize,
+	int tileSize) const {
+	drawBasicCursor(window, mousePos, view, 1, tileSize,
+		sf::Color(0, 200, 255, 100));
+}
+
+/**
+ * スキャンライン塗りつぶし
+ * 種から左右へ同じタイルが続く範囲を1区間として塗り、上下の行で
+ * その範囲（8近傍では左右に1タイル広げた範囲）に接する区間の先頭を種として積む
+ * 塗った区間は target と異なる値になるため、同じ区間を2回塗ることはない
+ */
+int FillTool::floodFill(Canvas& canvas, int x, int y, int patternIndex) {
+	const TileGrid& tiles = canvas.getTiles();
+	if (!tiles.contains(x, y)) return 0;
+
+	const int target = tiles.get(x, y);
+	const int replacement = TileGrid::toCell(patternIndex);
+	if (target == replacement) return 0;
+
+	const int width = tiles.getWidth();
+	const int reach = eightConnected ? 1 : 0;
+	int filledCount = 0;
+
+	seedStack.clear();
+	seedStack.push_back(sf::Vector2i(x, y));
+	while (!seedStack.empty()) {
+		const sf::Vector2i seed = seedStack.back();
+		seedStack.pop_back();
+		if (tiles.get(seed.x, seed.y) != target) continue; // 他の区間から塗られた種
+
+		int left = seed.x;
+		int right = seed.x + 1;
+		while (left > 0 && tiles.get(left - 1, seed.y) == target) --left;
+		while (right < width && tiles.get(right, seed.y) == target) ++right;
+
+		filledCount += canvas.fillTileSpan(seed.y, left, right, replacement);
+		pushSeeds(canvas, seed.y - 1, left - reach, right + reach, target);
+		pushSeeds(canvas, seed.y + 1, left - reach, right + reach, target);
+	}
+	return filledCount;
+}
 
-	int centerX = static_cast<int>(params.centerX);
-	int centerY = static_cast<int>(params.centerY);
-	int radiusX = static_cast<int>(params.radiusX);
-	int radiusY = static_cast<int>(params.radiusY);
-
-	// 楕円描画用の点群を生成
-	std::set<std::pair<int, int>> ellipsePoints;
-
-	// 中点楕円アルゴリズム
-	int x = 0;
-	int y = radiusY;
-
-	// 楕円の初期決定パラメータ
-	int radiusX2 = radiusX * radiusX;
-	int radiusY2 = radiusY * radiusY;
-	int twoRadiusX2 = 2 * radiusX2;
-	int twoRadiusY2 = 2 * radiusY2;
-
-	// 領域1の処理
-	int p1 = radiusY2 - (radiusX2 * radiusY) + (0.25f * radiusX2);
-	int dx = twoRadiusY2 * x;
-	int dy = twoRadiusX2 * y;
-
-	// 4つの対称点を追加する関数
-	auto addSymmetricPoints = [&](int x, int y) {
-		ellipsePoints.insert({ centerX + x, centerY + y });
-		ellipsePoints.insert({ centerX - x, centerY + y });
-		ellipsePoints.insert({ centerX + x, centerY - y });
-		ellipsePoints.insert({ centerX - x, centerY - y });
-		};
-
-	// 領域1：dx < dy まで
-	while (dx < dy) {
-		addSymmetricPoints(x, y);
-
-		if (p1 < 0) {
-			x++;
-			dx = twoRadiusY2 * x;
-			p1 = p1 + dx + radiusY2;
+void FillTool::pushSeeds(const Canvas& canvas, int y, int x0, int x1, int target) {
+	const TileGrid& tiles = canvas.getTiles();
+	if (y < 0 || y >= tiles.getHeight()) return;
+	x0 = std::max(0, x0);
+	x1 = std::min(tiles.getWidth(), x1);
+	if (x1 <= x0) return;
+
+	rowBuffer.resize(x1 - x0);
+	tiles.readRow(y, x0, x1, rowBuffer.data());
+
+	bool inRun = false;
+	for (int i = 0; i < x1 - x0; ++i) {
+		const bool match = rowBuffer[i] == target;
+		if (match && !inRun) {
+			seedStack.push_back(sf::Vector2i(x0 + i, y));
 		}
-		else {
-			x++;
-			y--;
-			dx = twoRadiusY2 * x;
-			dy = twoRadiusX2 * y;
-			p1 = p1 + dx - dy + radiusY2;
+		inRun = match;
+	}
+}
+
+/**
+ * キャンバス全体の置き換え
+ * 1行ずつ読み出して一致する区間ごとに書き込む（空以外の置き換えでは空の行を読まない）
+ */
+int FillTool::replaceAllMatching(Canvas& canvas, int target, int patternIndex) {
+	const TileGrid& tiles = canvas.getTiles();
+	const int replacement = TileGrid::toCell(patternIndex);
+	target = TileGrid::toCell(target);
+	if (target == replacement) return 0;
+
+	const int width = tiles.getWidth();
+	int filledCount = 0;
+	rowBuffer.resize(width);
+	for (int y = 0; y < tiles.getHeight(); ++y) {
+		if (target != TileGrid::EMPTY && tiles.isRegionEmpty(sf::IntRect(0, y, width, 1))) continue;
+		tiles.readRow(y, 0, width, rowBuffer.data());
+
+		int runStart = -1;
+		for (int x = 0; x <= width; ++x) {
+			const bool match = x < width && rowBuffer[x] == target;
+			if (match && runStart < 0) {
+				runStart = x;
+			}
+			else if (!match && runStart >= 0) {
+				filledCount += canvas.fillTileSpan(y, runStart, x, replacement);
+				runStart = -1;
+			}
 		}
 	}
+	return filledCount;
+}
 
-	// 領域2の初期パラメータ
-	int p2 = radiusY2 * (x + 0.5f) * (x + 0.5f) + radiusX2 * (y - 1) * (y - 1) - radiusX2 * radiusY2;
+// ===== TileBlock 実装 =====
 
-	// 領域2：y >= 0 まで
-	while (y >= 0) {
-		addSymmetricPoints(x, y);
+void TileBlock::flipHorizontal() {
+	for (int y = 0; y < height; ++y) {
+		std::reverse(row(y), row(y) + width);
+	}
+}
 
-		if (p2 > 0) {
-			y--;
-			dy = twoRadiusX2 * y;
-			p2 = p2 - dy + radiusX2;
-		}
-		else {
-			y--;
-			x++;
-			dx = twoRadiusY2 * x;
-			dy = twoRadiusX2 * y;
-			p2 = p2 + dx - dy + radiusX2;
+void TileBlock::flipVertical() {
+	for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom) {
+		std::swap_ranges(row(top), row(top) + width, row(bottom));
+	}
+}
+
+/**
+ * 時計回りに90度回転
+ * 元の (x, y) は回転後の (height - 1 - y, x) へ移る（幅と高さが入れ替わる）
+ */
+void TileBlock::rotateClockwise() {
+	std::vector<int8_t> rotated(cells.size());
+	const int rotatedWidth = height;
+	for (int y = 0; y < height; ++y) {
+		const int8_t* source = row(y);
+		for (int x = 0; x < width; ++x) {
+			rotated[static_cast<std::size_t>(x) * rotatedWidth + (height - 1 - y)] = source[x];
 		}
 	}
+	cells.swap(rotated);
+	std::swap(width, height);
+}
 
-	// 生成された点にブラシを適用
-	for (const auto& point : ellipsePoints) {
-		sf::Vector2i screenPos(point.first, point.second);
-		if (canvas.containsInView(view, screenPos)) {
-			applyBrushAt(screenPos, brushSize, canvas, view, patternIndex);
+// ===== SelectionTool 実装 =====
+
+/**
+ * 選択ツール：描画開始
+ * 選択範囲の内側なら移動、外側なら新しい矩形の選択を始める
+ */
+void SelectionTool::onDrawStart(const sf::Vector2i& startPos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex,
+	int brushSize) {
+	rememberCanvas(canvas);
+	anchorTile = canvas.screenToTileIndex(view, startPos);
+	dragMode = hasSelection() && selection.contains(anchorTile) ? DragMode::Moving : DragMode::Selecting;
+}
+
+/**
+ * 選択ツール：描画継続
+ * 連続描画ではないので何もしない（ドラッグ中の範囲はプレビューで表示）
+ */
+void SelectionTool::onDrawContinue(const sf::Vector2i& currentPos,
+	const sf::Vector2i& lastPos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex,
+	int brushSize) {
+	// 範囲はドラッグ終了時に確定
+}
+
+/**
+ * 選択ツール：描画終了
+ * 選択中なら矩形を確定（その場でのクリックは選択解除）、移動中ならずらした位置へ移動する
+ */
+void SelectionTool::onDrawEnd(const sf::Vector2i& endPos,
+	const sf::Vector2i& startPos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex,
+	int brushSize) {
+	rememberCanvas(canvas);
+	const sf::Vector2i endTile = canvas.screenToTileIndex(view, endPos);
+
+	if (dragMode == DragMode::Selecting) {
+		selection = endTile == anchorTile ? sf::IntRect() : clipToCanvas(tileRectBetween(anchorTile, endTile));
+	}
+	else if (dragMode == DragMode::Moving) {
+		moveSelection(canvas, endTile - anchorTile);
+	}
+	dragMode = DragMode::None;
+}
+
+/**
+ * 選択ツール：プレビュー描画
+ * 確定済みの選択範囲の枠と、ドラッグ中の矩形（または移動先）を表示
+ */
+void SelectionTool::drawPreview(sf::RenderWindow& window,
+	const sf::Vector2i& startPos,
+	const sf::Vector2i& currentPos,
+	const CanvasView& view,
+	int brushSize) const {
+	const sf::Vector2i currentTile = screenToTile(view, currentPos);
+
+	if (dragMode == DragMode::Selecting) {
+		drawTileRect(window, view, clipToCanvas(tileRectBetween(anchorTile, currentTile)),
+			sf::Color(100, 180, 255, 40), sf::Color(100, 180, 255, 220));
+		return;
+	}
+	if (!hasSelection()) return;
+
+	if (dragMode == DragMode::Moving) {
+		const sf::Vector2i offset = currentTile - anchorTile;
+		drawTileRect(window, view, selection, sf::Color::Transparent, sf::Color(255, 255, 255, 80));
+		drawTileRect(window, view,
+			sf::IntRect(selection.left + offset.x, selection.top + offset.y, selection.width, selection.height),
+			sf::Color(255, 220, 100, 40), sf::Color(255, 220, 100, 220));
+		return;
+	}
+	drawTileRect(window, view, selection, sf::Color(100, 180, 255, 30), sf::Color(100, 180, 255, 200));
+}
+
+/**
+ * 選択ツール：カーソル描画
+ * 1タイル分のカーソル（選択範囲の内側では移動を示す色）
+ */
+void SelectionTool::drawCursor(sf::RenderWindow& window,
+	const sf::Vector2i& mousePos,
+	const CanvasView& view,
+	int brushSize,
+	int tileSize) const {
+	const bool overSelection = hasSelection() && selection.contains(screenToTile(view, mousePos));
+	drawBasicCursor(window, mousePos, view, 1, tileSize,
+		overSelection ? sf::Color(255, 220, 100, 100) : sf::Color(100, 180, 255, 100));
+}
+
+/**
+ * 選択ツール：キー入力
+ */
+bool SelectionTool::onKeyPressed(const sf::Event::KeyEvent& key,
+	const sf::Vector2i& mousePos,
+	Canvas& canvas,
+	const CanvasView& view,
+	int patternIndex) {
+	rememberCanvas(canvas);
+
+	if (key.control) {
+		switch (key.code) {
+		case sf::Keyboard::C:
+			copySelection(canvas);
+			return true;
+		case sf::Keyboard::X:
+			cutSelection(canvas);
+			return true;
+		case sf::Keyboard::V:
+			// マウスがキャンバス外なら選択範囲の左上（選択がなければキャンバスの左上）へ貼り付け
+			if (canvas.containsInView(view, mousePos)) {
+				pasteAt(canvas, canvas.screenToTileIndex(view, mousePos));
+			}
+			else {
+				pasteAt(canvas, sf::Vector2i(selection.left, selection.top));
+			}
+			return true;
+		case sf::Keyboard::A:
+			selection = sf::IntRect(0, 0, canvas.getWidth(), canvas.getHeight());
+			return true;
+		default:
+			return false;
 		}
 	}
+
+	switch (key.code) {
+	case sf::Keyboard::Escape:
+		clearSelection();
+		return true;
+	case sf::Keyboard::Delete:
+	case sf::Keyboard::BackSpace:
+		fillSelection(canvas, -1);
+		return true;
+	case sf::Keyboard::Return:
+		fillSelection(canvas, patternIndex);
+		return true;
+	case sf::Keyboard::H:
+		clipboard.flipHorizontal();
+		lastAction = "Flipped H";
+		return true;
+	case sf::Keyboard::V:
+		clipboard.flipVertical();
+		lastAction = "Flipped V";
+		return true;
+	case sf::Keyboard::T:
+		clipboard.rotateClockwise();
+		lastAction = "Rotated 90";
+		return true;
+	default:
+		return false;
+	}
+}
+
+void SelectionTool::copySelection(const Canvas& canvas) {
+	if (!hasSelection()) return;
+	readBlock(canvas, selection, clipboard);
+	lastAction = "Copied";
+}
+
+void SelectionTool::cutSelection(Canvas& canvas) {
+	if (!hasSelection()) return;
+	copySelection(canvas);
+	fillSelection(canvas, -1);
+	lastAction = "Cut";
+}
+
+void SelectionTool::pasteAt(Canvas& canvas, const sf::Vector2i& topLeft) {
+	if (clipboard.empty()) return;
+	writeBlock(canvas, clipboard, topLeft);
+	selection = clipToCanvas(sf::IntRect(topLeft.x, topLeft.y, clipboard.width, clipboard.height));
+	lastAction = "Pasted";
+}
+
+void SelectionTool::fillSelection(Canvas& canvas, int patternIndex) {
+	if (!hasSelection()) return;
+	for (int y = selection.top; y < selection.top + selection.height; ++y) {
+		canvas.fillTileSpan(y, selection.left, selection.left + selection.width, patternIndex);
+	}
+	lastAction = patternIndex < 0 ? "Erased" : "Filled";
+}
+
+void SelectionTool::moveSelection(Canvas& canvas, const sf::Vector2i& offset) {
+	if (!hasSelection() || (offset.x == 0 && offset.y == 0)) return;
+
+	// 移動元を退避してから消去し、移動先へ書き込む（範囲が重なっていても元の内容を保つ）
+	readBlock(canvas, selection, moveBuffer);
+	fillSelection(canvas, -1);
+	const sf::Vector2i target(selection.left + offset.x, selection.top + offset.y);
+	writeBlock(canvas, moveBuffer, target);
+	selection = clipToCanvas(sf::IntRect(target.x, target.y, moveBuffer.width, moveBuffer.height));
+	lastAction = "Moved";
+}
+
+void SelectionTool::rememberCanvas(const Canvas& canvas) {
+	canvasOrigin = canvas.getPosition();
+	canvasTileSize = canvas.getTileSize();
+	canvasTiles = sf::Vector2i(canvas.getWidth(), canvas.getHeight());
+}
+
+/**
+ * スクリーン座標をタイル座標に変換（Canvas::screenToTileIndex と同じ計算を保持した配置で行う）
+ */
+sf::Vector2i SelectionTool::screenToTile(const CanvasView& view, const sf::Vector2i& screenPos) const {
+	sf::Vector2f localPos = static_cast<sf::Vector2f>(view.screenToCanvas(screenPos)) - canvasOrigin;
+	return sf::Vector2i(
+		static_cast<int>(std::floor(localPos.x / canvasTileSize)),
+		static_cast<int>(std::floor(localPos.y / canvasTileSize)));
+}
+
+sf::IntRect SelectionTool::clipToCanvas(const sf::IntRect& rect) const {
+	sf::IntRect clipped;
+	if (!rect.intersects(sf::IntRect(0, 0, canvasTiles.x, canvasTiles.y), clipped)) {
+		return sf::IntRect();
+	}
+	return clipped;
+}
+
+sf::IntRect SelectionTool::tileRectBetween(const sf::Vector2i& a, const sf::Vector2i& b) {
+	const int left = std::min(a.x, b.x);
+	const int top = std::min(a.y, b.y);
+	return sf::IntRect(left, top, std::max(a.x, b.x) - left + 1, std::max(a.y, b.y) - top + 1);
+}
+
+void SelectionTool::readBlock(const Canvas& canvas, const sf::IntRect& rect, TileBlock& block) {
+	const TileGrid& tiles = canvas.getTiles();
+	block.resize(rect.width, rect.height);
+	for (int y = 0; y < rect.height; ++y) {
+		tiles.readRow(rect.top + y, rect.left, rect.left + rect.width, block.row(y));
+	}
 }
 
+void SelectionTool::writeBlock(Canvas& canvas, const TileBlock& block, const sf::Vector2i& topLeft) {
+	for (int y = 0; y < block.height; ++y) {
+		canvas.writeTileRow(topLeft.y + y, topLeft.x, block.row(y), block.width);
+	}
+}
+
+/**
+ * タイル座標の矩形をスクリーン上に描画
+ */
+void SelectionTool::drawTileRect(sf::RenderWindow& window,
+	const CanvasView& view,
+	const sf::IntRect& rect,
+	const sf::Color& fillColor,
+	const sf::Color& outlineColor) const {
+	if (rect.width <= 0 || rect.height <= 0) return;
+
+	const sf::Vector2i topLeft = view.canvasToScreen(sf::Vector2i(
+		static_cast<int>(canvasOrigin.x) + rect.left * canvasTileSize,
+		static_cast<int>(canvasOrigin.y) + rect.top * canvasTileSize));
+	const sf::Vector2i bottomRight = view.canvasToScreen(sf::Vector2i(
+		static_cast<int>(canvasOrigin.x) + (rect.left + rect.width) * canvasTileSize,
+		static_cast<int>(canvasOrigin.y) + (rect.top + rect.height) * canvasTileSize));
+
+	sf::RectangleShape shape(static_cast<sf::Vector2f>(bottomRight - topLeft));
+	shape.setPosition(static_cast<sf::Vector2f>(topLeft));
+	shape.setFillColor(fillColor);
+	shape.setOutlineThickness(1.0f);
+	shape.setOutlineColor(outlineColor);
+	window.draw(shape);
+}
 
 // ===== ToolManager 実装 =====
 
@@ -921,8 +1342,58 @@ void ToolManager::setTool(ToolType toolType) {
 	case ToolType::LARGE_TILE:  // 新規追加
 		currentTool = std::make_unique<LargeTileTool>();
 		break;
+	case ToolType::FILL:
+	{
+		auto fillTool = std::make_unique<FillTool>();
+		fillTool->setEightConnected(fillEightConnected);
+		fillTool->setReplaceAll(fillReplaceAll);
+		currentTool = std::move(fillTool);
+		break;
+	}
+	case ToolType::SELECT:
+		currentTool = std::make_unique<SelectionTool>(clipboard);
+		break;
 	}
 
+	if (currentTool) {
+		currentTool->setBrushShape(brushShape);
+		currentTool->setFilled(shapeFilled);
+	}
+}
+
+/**
+ * 塗りつぶしツールの設定
+ * 現在のツールが塗りつぶしツールなら即座に反映
+ */
+void ToolManager::setFillOptions(bool eightConnected, bool replaceAll) {
+	fillEightConnected = eightConnected;
+	fillReplaceAll = replaceAll;
+	if (auto* fillTool = dynamic_cast<FillTool*>(currentTool.get())) {
+		fillTool->setEightConnected(eightConnected);
+		fillTool->setReplaceAll(replaceAll);
+	}
+}
+
+/**
+ * 図形ツールの塗りつぶしモードを設定
+ * 現在のツールと、以降に生成するツールへ反映
+ */
+void ToolManager::setShapeFilled(bool value) {
+	shapeFilled = value;
+	if (currentTool) {
+		currentTool->setFilled(value);
+	}
+}
+
+/**
+ * ブラシ形状を設定
+ * 現在のツールと、以降に生成するツールへ反映
+ */
+void ToolManager::setBrushShape(BrushMask::Shape shape) {
+	brushShape = shape;
+	if (currentTool) {
+		currentTool->setBrushShape(shape);
+	}
 }
 
 /**
@@ -3,7 +3,9 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
-#include <set>
+#include <vector>
+#include <cstdint>
+#include "BrushMask.hpp"
 
 // O錾
 class Canvas;
@@ -102,9 +104,58 @@ public:
 	 */
 	virtual bool supportsContinuousDrawing() const = 0;
 
+	/**
+	 * c[ŗL̃L[͏
+	 * @param key L[Cxg
+	 * @param mousePos }EXʒuiXN[Wj
+	 * @param canvas `ΏۃLoX
+	 * @param view CanvasViewCX^X
+	 * @param patternIndex Iꂽp^[CfbNX
+	 * @return L[ꍇtrueĩV[gJbgɂ͓nȂj
+	 */
+	virtual bool onKeyPressed(const sf::Event::KeyEvent& key,
+		const sf::Vector2i& mousePos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex) {
+		return false;
+	}
+
+	/**
+	 * hbOȊOvr[\邩iI͈̘͂gȂǁj
+	 */
+	virtual bool hasPersistentPreview() const { return false; }
+
+	/**
+	 * uV`ilpEہj̐ݒ
+	 */
+	void setBrushShape(BrushMask::Shape shape) { brushShape = shape; }
+	BrushMask::Shape getBrushShape() const { return brushShape; }
+
+	/**
+	 * }`c[i~Eȉ~j̓hԂ[h
+	 */
+	void setFilled(bool value) { filled = value; }
+	bool isFilled() const { return filled; }
+
 protected:
+	BrushMask::Shape brushShape = BrushMask::Shape::Square;
+	bool filled = false;
+
+	// stampBrushLine ̍sƂ̑|͈ [sweepLeft, sweepRight)iXg[NƂɍėpj
+	mutable std::vector<int> sweepLeft;
+	mutable std::vector<int> sweepRight;
+
+	// stampEllipse ̏o͍sƂ̍Ȇ [leftMin, leftMax)E[rightMin, rightMax)
+	struct RowBands {
+		int leftMin, leftMax;
+		int rightMin, rightMax;
+	};
+	mutable std::vector<RowBands> shapeBands;
+
 	/**
 	 * uVwʒuɓKpwp[֐
+	 * S^CW1񂾂ϊAstampBrush œKp
 	 * @param position ʒuiXN[Wj
 	 * @param brushSize uVTCY
 	 * @param canvas `ΏۃLoX
@@ -117,8 +168,54 @@ protected:
 		const CanvasView& view,
 		int patternIndex) const;
 
+	/**
+	 * OuV}XNsPʂ̋ԂƂă^CW֏
+	 * LoXO͐̕؂l߂iSLoXOłdȂ镔͕`悳j
+	 * @param centerTile uVSi^CWj
+	 * @param brushSize uVTCYi1`BrushMask::MAX_SIZEj
+	 * @param canvas `ΏۃLoX
+	 * @param patternIndex p^[CfbNXi-1ŏj
+	 */
+	void stampBrush(const sf::Vector2i& centerTile,
+		int brushSize,
+		Canvas& canvas,
+		int patternIndex) const;
+
+	/**
+	 * ^CW̐ɉăuV|AsƂ̋ԂƂĂ܂Ƃ߂ď
+	 * SBresenhamŃ^CPʂɐi߁AeʒũuV}XNsƂ [ŏ, ő] ɓ
+	 * RXg͒ʉ߂^CɔႵAY[{}EẌړxɈˑȂ
+	 * @param startTile Jnʒui^CWj
+	 * @param endTile Iʒui^CWj
+	 * @param brushSize uVTCY
+	 * @param canvas `ΏۃLoX
+	 * @param patternIndex p^[CfbNXi-1ŏj
+	 */
+	void stampBrushLine(const sf::Vector2i& startTile,
+		const sf::Vector2i& endTile,
+		int brushSize,
+		Canvas& canvas,
+		int patternIndex) const;
+
+	/**
+	 * ^CW̋`ɓڂȉ~sƂ̋ԂƂď
+	 * es̑ȉ~͈̔͂߁A֊s͏㉺̍sƂȂ鍶E̋ԂɃuV}XNLтƂāA
+	 * hԂ͍sŜƂ1sɂő2݂̏Ŋm肷
+	 * @param bounds Oڋ`i^CWAE1ȏj
+	 * @param fill hԂꍇtrue
+	 * @param brushSize ֊s̃uVTCY
+	 * @param canvas `ΏۃLoX
+	 * @param patternIndex p^[CfbNXi-1ŏj
+	 */
+	void stampEllipse(const sf::IntRect& bounds,
+		bool fill,
+		int brushSize,
+		Canvas& canvas,
+		int patternIndex) const;
+
 	/**
 	 * ɉăuVKpwp[֐
+	 * [^CWɕϊ stampBrushLine œKp
 	 * @param startPos JnʒuiXN[Wj
 	 * @param endPos IʒuiXN[Wj
 	 * @param brushSize uVTCY
@@ -318,25 +415,8 @@ public:
 		int brushSize,
 		int tileSize) const override;
 
-	std::string getToolName() const override { return "Circle"; }
+	std::string getToolName() const override { return filled ? "Filled Circle" : "Circle"; }
 	bool supportsContinuousDrawing() const override { return false; }
-
-private:
-	/**
-	 * ~̓_vZăuVKp
-	 * @param centerPos SʒuiXN[Wj
-	 * @param radius aiXN[Wj
-	 * @param brushSize uVTCY
-	 * @param canvas `ΏۃLoX
-	 * @param view CanvasViewCX^X
-	 * @param patternIndex p^[CfbNX
-	 */
-	void drawCircle(const sf::Vector2i& centerPos,
-		float radius,
-		int brushSize,
-		Canvas& canvas,
-		const CanvasView& view,
-		int patternIndex) const;
 };
 
 
@@ -378,26 +458,10 @@ public:
 		int brushSize,
 		int tileSize) const override;
 
-	std::string getToolName() const override { return "Ellipse"; }
+	std::string getToolName() const override { return filled ? "Filled Ellipse" : "Ellipse"; }
 	bool supportsContinuousDrawing() const override { return false; }
 
 private:
-	/**
-	 * ȉ~̋E`
-	 * @param topLeft ȉ~͂ދ`̍piXN[Wj
-	 * @param bottomRight ȉ~͂ދ`̉EpiXN[Wj
-	 * @param brushSize uVTCY
-	 * @param canvas `ΏۃLoX
-	 * @param view CanvasViewCX^X
-	 * @param patternIndex p^[CfbNX
-	 */
-	void drawEllipse(const sf::Vector2i& topLeft,
-		const sf::Vector2i& bottomRight,
-		int brushSize,
-		Canvas& canvas,
-		const CanvasView& view,
-		int patternIndex) const;
-
 	/**
 	 * ȉ~p[^̌vZ
 	 * @param topLeft p
@@ -414,6 +478,257 @@ private:
 };
 
 
+/**
+ * hԂc[
+ * NbN^CƓ^CÄAXLCisPʂ̋ԁjœhԂ
+ * ċA͎g킸IȃX^bNŏARXg͓hʐςƋE̒ɔႷ
+ */
+class FillTool : public DrawingTool {
+public:
+	void onDrawStart(const sf::Vector2i& startPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void onDrawContinue(const sf::Vector2i& currentPos,
+		const sf::Vector2i& lastPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void onDrawEnd(const sf::Vector2i& endPos,
+		const sf::Vector2i& startPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void drawPreview(sf::RenderWindow& window,
+		const sf::Vector2i& startPos,
+		const sf::Vector2i& currentPos,
+		const CanvasView& view,
+		int brushSize) const override;
+
+	void drawCursor(sf::RenderWindow& window,
+		const sf::Vector2i& mousePos,
+		const CanvasView& view,
+		int brushSize,
+		int tileSize) const override;
+
+	std::string getToolName() const override { return replaceAll ? "Fill (Replace All)" : "Fill"; }
+	bool supportsContinuousDrawing() const override { return false; }
+
+	/**
+	 * A̔ifalse: ㉺E4ߖTAtrue: ΂߂܂8ߖTj
+	 */
+	void setEightConnected(bool value) { eightConnected = value; }
+	bool isEightConnected() const { return eightConnected; }
+
+	/**
+	 * AɊ֌WȂALoXŜ̓^Cu邩
+	 */
+	void setReplaceAll(bool value) { replaceAll = value; }
+	bool isReplaceAll() const { return replaceAll; }
+
+	/**
+	 * (x, y) A铯^C̗̈hԂ
+	 * @return hւ^C
+	 */
+	int floodFill(Canvas& canvas, int x, int y, int patternIndex);
+
+	/**
+	 * LoXŜ target Ɠ^C patternIndex ɒu
+	 * @return hւ^C
+	 */
+	int replaceAllMatching(Canvas& canvas, int target, int patternIndex);
+
+private:
+	bool eightConnected = false;
+	bool replaceAll = false;
+
+	// p̍Ɨ̈ihԂƂɍėpj
+	std::vector<sf::Vector2i> seedStack;   // ̎i^CWj
+	std::vector<int8_t> rowBuffer;         // אڍs̓ǂݏop
+
+	/**
+	 * s y  [x0, x1)  target Ɠ^CAԂƂɁA擪ƂĐς
+	 */
+	void pushSeeds(const Canvas& canvas, int y, int x0, int x1, int target);
+};
+
+/**
+ * ^C̋`ubNiNbv{[hEړpj
+ * sD̖ȔzŕێALoXƂ1s܂Ƃ߂ēǂݏ
+ */
+struct TileBlock {
+	int width = 0;
+	int height = 0;
+	std::vector<int8_t> cells;
+
+	bool empty() const { return width <= 0 || height <= 0; }
+
+	void resize(int newWidth, int newHeight) {
+		width = newWidth;
+		height = newHeight;
+		cells.resize(static_cast<std::size_t>(width) * height);
+	}
+
+	int8_t* row(int y) { return cells.data() + static_cast<std::size_t>(y) * width; }
+	const int8_t* row(int y) const { return cells.data() + static_cast<std::size_t>(y) * width; }
+
+	// E]E㉺]Ev90x]
+	void flipHorizontal();
+	void flipVertical();
+	void rotateClockwise();
+};
+
+/**
+ * Ic[
+ * hbOŃ^CPʂ̋`IAĨ͈͓hbOňړ
+ * Rs[E؂E\tEEhԂ͍sPʂ̈ꊇ݂ŏ
+ *
+ * L[iIc[gpjF
+ *   Ctrl+C / Ctrl+X / Ctrl+V : Rs[ / ؂ / }EXʒu֓\t
+ *   Ctrl+A : ׂđIAEsc : I
+ *   Delete : AEnter : I𒆂̃p^[œhԂ
+ *   H / V / T : Nbv{[hE] / ㉺] / 90x]
+ */
+class SelectionTool : public DrawingTool {
+public:
+	/**
+	 * @param clipboard c[؂ւĂێNbv{[hiToolManagerLj
+	 */
+	explicit SelectionTool(TileBlock& clipboard) : clipboard(clipboard) {}
+
+	void onDrawStart(const sf::Vector2i& startPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void onDrawContinue(const sf::Vector2i& currentPos,
+		const sf::Vector2i& lastPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void onDrawEnd(const sf::Vector2i& endPos,
+		const sf::Vector2i& startPos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex,
+		int brushSize) override;
+
+	void drawPreview(sf::RenderWindow& window,
+		const sf::Vector2i& startPos,
+		const sf::Vector2i& currentPos,
+		const CanvasView& view,
+		int brushSize) const override;
+
+	void drawCursor(sf::RenderWindow& window,
+		const sf::Vector2i& mousePos,
+		const CanvasView& view,
+		int brushSize,
+		int tileSize) const override;
+
+	bool onKeyPressed(const sf::Event::KeyEvent& key,
+		const sf::Vector2i& mousePos,
+		Canvas& canvas,
+		const CanvasView& view,
+		int patternIndex) override;
+
+	std::string getToolName() const override { return "Select"; }
+	bool supportsContinuousDrawing() const override { return false; }
+	bool hasPersistentPreview() const override { return true; }
+
+	/**
+	 * Í͈i^CWALoXɐ؂lߍς݁j
+	 */
+	bool hasSelection() const { return selection.width > 0 && selection.height > 0; }
+	const sf::IntRect& getSelection() const { return selection; }
+	void clearSelection() { selection = sf::IntRect(); }
+	const TileBlock& getClipboard() const { return clipboard; }
+
+	/**
+	 * Ȏ̕\peLXgic[̗ɕ\AȂ󕶎j
+	 */
+	const char* getLastAction() const { return lastAction; }
+
+	/**
+	 * I͈͂Nbv{[hփRs[
+	 */
+	void copySelection(const Canvas& canvas);
+
+	/**
+	 * I͈͂Nbv{[hփRs[ď
+	 */
+	void cutSelection(Canvas& canvas);
+
+	/**
+	 * Nbv{[h topLeft Ƃē\tA\t͈͂I
+	 * @param topLeft \tʒui^CWALoXO͐̕؂l߂j
+	 */
+	void pasteAt(Canvas& canvas, const sf::Vector2i& topLeft);
+
+	/**
+	 * I͈͂𓯂^CŖ߂
+	 * @param patternIndex p^[CfbNXi-1ŏj
+	 */
+	void fillSelection(Canvas& canvas, int patternIndex);
+
+	/**
+	 * I͈͂̓e offset ړiړ͏AdȂ肪Ăړj
+	 */
+	void moveSelection(Canvas& canvas, const sf::Vector2i& offset);
+
+private:
+	enum class DragMode {
+		None,
+		Selecting,  // V`I
+		Moving      // I͈͂ړ
+	};
+
+	TileBlock& clipboard;
+	TileBlock moveBuffer;          // ړ̈ꎞ̈iړƂɍėpj
+	sf::IntRect selection;
+	DragMode dragMode = DragMode::None;
+	sf::Vector2i anchorTile;       // hbOJnʒui^CWj
+	const char* lastAction = "";   // ȎiÓIȕ̂݁j
+
+	// vr[`pɁA߂̑쎞̃LoXzuێ
+	sf::Vector2f canvasOrigin;
+	int canvasTileSize = 1;
+	sf::Vector2i canvasTiles;
+
+	void rememberCanvas(const Canvas& canvas);
+	sf::Vector2i screenToTile(const CanvasView& view, const sf::Vector2i& screenPos) const;
+	sf::IntRect clipToCanvas(const sf::IntRect& rect) const;
+
+	/**
+	 * 2_i^CWA[܂ށjΊpƂ`
+	 */
+	static sf::IntRect tileRectBetween(const sf::Vector2i& a, const sf::Vector2i& b);
+
+	/**
+	 * LoX̋`͈́iLoXj1s block ֓ǂݏo
+	 */
+	static void readBlock(const Canvas& canvas, const sf::IntRect& rect, TileBlock& block);
+
+	/**
+	 * block  topLeft Ƃ1sLoX֏
+	 */
+	static void writeBlock(Canvas& canvas, const TileBlock& block, const sf::Vector2i& topLeft);
+
+	void drawTileRect(sf::RenderWindow& window,
+		const CanvasView& view,
+		const sf::IntRect& rect,
+		const sf::Color& fillColor,
+		const sf::Color& outlineColor) const;
+};
+
 /**
  * c[ǗNX
  * ec[̐E؂ւǗ
@@ -429,7 +744,9 @@ public:
 		LINE,
 		CIRCLE,  // VKǉ
 		 ELLIPSE, // VKǉ
-		LARGE_TILE  // VKǉ
+		LARGE_TILE,  // VKǉ
+		FILL,
+		SELECT
 	};
 
 	ToolManager();
@@ -450,6 +767,27 @@ public:
 	 */
 	ToolType getCurrentToolType() const;
 
+	/**
+	 * uV`ݒic[؂ւĂێj
+	 */
+	void setBrushShape(BrushMask::Shape shape);
+	BrushMask::Shape getBrushShape() const { return brushShape; }
+
+	/**
+	 * }`c[̓hԂ[hݒic[؂ւĂێj
+	 */
+	void setShapeFilled(bool value);
+	bool isShapeFilled() const { return shapeFilled; }
+
+	/**
+	 * hԂc[̐ݒic[؂ւĂێj
+	 * @param eightConnected 8ߖTŘA𔻒肷ꍇtrue
+	 * @param replaceAll LoXŜ̓^Cuꍇtrue
+	 */
+	void setFillOptions(bool eightConnected, bool replaceAll);
+	bool isFillEightConnected() const { return fillEightConnected; }
+	bool isFillReplaceAll() const { return fillReplaceAll; }
+
 	/**
 	 * c[擾
 	 */
@@ -457,4 +795,9 @@ public:
 
 private:
 	ToolType currentToolType = ToolType::BRUSH;
+	BrushMask::Shape brushShape = BrushMask::Shape::Square;
+	bool shapeFilled = false;
+	bool fillEightConnected = false;
+	bool fillReplaceAll = false;
+	TileBlock clipboard;   // Ic[̃Nbv{[hic[؂ւĂێj
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <array>
+#include <cstdint>
+#include "UIHelper.hpp"
 
 class GlobalColorPalette {
 private:
@@ -11,6 +13,37 @@ private:
     sf::Vector2f position;
     float colorBoxSize;
 
+    // ύXmp̃o[WԍiFς邽тɒPj
+    uint64_t colorVersion = 0;
+
+    // `LbV
+    sf::VertexArray cachedVertices;
+    bool cacheValid = false;
+    uint64_t cachedColorVersion = 0;
+    int cachedSelectedIndex = -1;
+
+    void buildVertices() {
+        cachedVertices.setPrimitiveType(sf::Quads);
+        cachedVertices.clear();
+
+        for (int i = 0; i < 16; ++i) {
+            float y = position.y + i * (colorBoxSize + 2);
+
+            // J[{bNXƘgiI̓nCCgj
+            appendQuad(cachedVertices, position.x, y, colorBoxSize, colorBoxSize, colors[i]);
+            if (i == selectedIndex) {
+                appendOutline(cachedVertices, position.x, y, colorBoxSize, colorBoxSize, 3, sf::Color::Yellow);
+            }
+            else {
+                appendOutline(cachedVertices, position.x, y, colorBoxSize, colorBoxSize, 1, sf::Color(100, 100, 100));
+            }
+        }
+
+        cachedColorVersion = colorVersion;
+        cachedSelectedIndex = selectedIndex;
+        cacheValid = true;
+    }
+
 public:
     GlobalColorPalette(sf::Vector2f pos, float boxSize)
         : position(pos), colorBoxSize(boxSize), selectedIndex(0) {
@@ -49,35 +82,16 @@ public:
         return false;
     }
 
-    // `
+    // `i_͐FEIEʒuςꍇ̂ݍĐj
     void draw(sf::RenderWindow& window) {
-        for (int i = 0; i < 16; ++i) {
-            float y = position.y + i * (colorBoxSize + 2);
-
-            // J[{bNX
-            sf::RectangleShape colorBox(sf::Vector2f(colorBoxSize, colorBoxSize));
-            colorBox.setPosition(position.x, y);
-            colorBox.setFillColor(colors[i]);
-
-            // ĨnCCg
-            if (i == selectedIndex) {
-                colorBox.setOutlineThickness(3);
-                colorBox.setOutlineColor(sf::Color::Yellow);
-            }
-            else {
-                colorBox.setOutlineThickness(1);
-                colorBox.setOutlineColor(sf::Color(100, 100, 100));
-            }
-
-            window.draw(colorBox);
+        if (!cacheValid || cachedColorVersion != colorVersion || cachedSelectedIndex != selectedIndex) {
+            buildVertices();
         }
+        window.draw(cachedVertices);
     }
 
     // F擾Eݒ
-    sf::Color& getSelectedColor() {
-        return colors[selectedIndex];
-    }
-
+    //  setColor oR̂݁io[Wԍ𐳂ۂ߁j
     const sf::Color& getSelectedColor() const {
         return colors[selectedIndex];
     }
@@ -90,8 +104,9 @@ public:
     }
 
     void setColor(int index, const sf::Color& color) {
-        if (index >= 0 && index < 16) {
+        if (index >= 0 && index < 16 && colors[index] != color) {
             colors[index] = color;
+            ++colorVersion;
         }
     }
 
@@ -109,8 +124,17 @@ public:
         return colors;
     }
 
+    /**
+     * F̃o[Wԍ擾
+     * ꂩ̐Fς邽тɑ
+     */
+    uint64_t getColorVersion() const {
+        return colorVersion;
+    }
+
     // ʒuݒ
     void setPosition(const sf::Vector2f& pos) {
         position = pos;
+        cacheValid = false;
     }
 };
\ No newline at end of file
@@ -0,0 +1,104 @@
+﻿#include "IndexedPalette.hpp"
+#include <iostream>
+
+namespace {
+    // Rチャンネルのスロット番号でルックアップテーブルを引く
+    const char* const PALETTE_FRAGMENT_SHADER =
+        "uniform sampler2D texture;\n"
+        "uniform sampler2D palette;\n"
+        "void main() {\n"
+        "    float slot = floor(texture2D(texture, gl_TexCoord[0].xy).r * 255.0 + 0.5);\n"
+        "    gl_FragColor = gl_Color * texture2D(palette, vec2((slot + 0.5) / 32.0, 0.5));\n"
+        "}\n";
+
+    // 2x2テクセルの中心をそれぞれ色に変換して平均（出力ピクセル中心は2x2ブロックの中心に当たる）
+    const char* const DOWNSAMPLE_FRAGMENT_SHADER =
+        "uniform sampler2D texture;\n"
+        "uniform sampler2D palette;\n"
+        "uniform vec2 texelSize;\n"
+        "vec4 lookup(vec2 uv) {\n"
+        "    float slot = floor(texture2D(texture, uv).r * 255.0 + 0.5);\n"
+        "    return texture2D(palette, vec2((slot + 0.5) / 32.0, 0.5));\n"
+        "}\n"
+        "void main() {\n"
+        "    vec2 uv = gl_TexCoord[0].xy;\n"
+        "    vec2 h = texelSize * 0.5;\n"
+        "    vec4 sum = lookup(uv + vec2(-h.x, -h.y)) + lookup(uv + vec2(h.x, -h.y))\n"
+        "        + lookup(uv + vec2(-h.x, h.y)) + lookup(uv + vec2(h.x, h.y));\n"
+        "    gl_FragColor = gl_Color * (sum * 0.25);\n"
+        "}\n";
+}
+
+bool IndexedPalette::initialize() {
+    available = false;
+
+    if (!sf::Shader::isAvailable()) {
+        std::cout << "Shaders not available: using direct color rendering" << std::endl;
+        return false;
+    }
+
+    if (!lookupTexture.create(SLOT_COUNT, 1)) {
+        std::cerr << "Error: Failed to create palette lookup texture" << std::endl;
+        return false;
+    }
+    lookupTexture.setSmooth(false);
+
+    shader = std::make_unique<sf::Shader>();
+    if (!shader->loadFromMemory(PALETTE_FRAGMENT_SHADER, sf::Shader::Fragment)) {
+        std::cerr << "Error: Failed to compile palette shader, using direct color rendering" << std::endl;
+        shader.reset();
+        return false;
+    }
+    shader->setUniform("texture", sf::Shader::CurrentTexture);
+    shader->setUniform("palette", lookupTexture);
+
+    // 縮小用シェーダーは任意（失敗時はLODを作らず通常表示）
+    downsampleShader = std::make_unique<sf::Shader>();
+    if (downsampleShader->loadFromMemory(DOWNSAMPLE_FRAGMENT_SHADER, sf::Shader::Fragment)) {
+        downsampleShader->setUniform("texture", sf::Shader::CurrentTexture);
+        downsampleShader->setUniform("palette", lookupTexture);
+    }
+    else {
+        std::cerr << "Error: Failed to compile palette downsample shader" << std::endl;
+        downsampleShader.reset();
+    }
+
+    // 未使用スロットは黒
+    for (int slot = 0; slot < SLOT_COUNT; ++slot) {
+        pixels[slot * 4 + 0] = 0;
+        pixels[slot * 4 + 1] = 0;
+        pixels[slot * 4 + 2] = 0;
+        pixels[slot * 4 + 3] = 255;
+    }
+    needsUpload = true;
+    available = true;
+    return true;
+}
+
+void IndexedPalette::setColor(int slot, const sf::Color& color) {
+    if (slot < 0 || slot >= SLOT_COUNT) return;
+
+    sf::Uint8* pixel = &pixels[slot * 4];
+    if (pixel[0] == color.r && pixel[1] == color.g && pixel[2] == color.b && pixel[3] == color.a) return;
+
+    pixel[0] = color.r;
+    pixel[1] = color.g;
+    pixel[2] = color.b;
+    pixel[3] = color.a;
+    needsUpload = true;
+    ++colorVersion;
+}
+
+void IndexedPalette::upload() {
+    if (!available || !needsUpload) return;
+    lookupTexture.update(pixels.data());
+    needsUpload = false;
+}
+
+const sf::Shader* IndexedPalette::getDownsampleShader(const sf::Vector2u& sourceSize) {
+    if (!available || !downsampleShader || sourceSize.x == 0 || sourceSize.y == 0) return nullptr;
+
+    downsampleShader->setUniform("texelSize",
+        sf::Vector2f(1.0f / sourceSize.x, 1.0f / sourceSize.y));
+    return downsampleShader.get();
+}
@@ -0,0 +1,68 @@
+﻿//===== IndexedPalette.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+/**
+ * インデックスカラー描画用のカラールックアップテーブル
+ * キャンバスのキャッシュテクスチャには色そのものではなくスロット番号（Rチャンネル）を書き込み、
+ * 表示時にシェーダーでこのテーブルを引いて実際の色に変換する
+ * 色の変更はテーブル（32x1テクスチャ）の更新のみで済む
+ */
+class IndexedPalette {
+public:
+    // スロット番号の割り当て（0-15はグローバルカラー）
+    static constexpr int GLOBAL_COLOR_COUNT = 16;
+    static constexpr int SLOT_BACKGROUND = 16; // キャンバス背景
+    static constexpr int SLOT_TILE_GRID = 17;  // タイル内部グリッド色
+    static constexpr int SLOT_FALLBACK = 18;   // 範囲外インデックス用（黒）
+    static constexpr int SLOT_COUNT = 32;
+
+    /**
+     * シェーダーとルックアップテーブルを準備
+     * @return シェーダーが使用できない環境ではfalse（呼び出し側は通常の色描画を使う）
+     */
+    bool initialize();
+
+    bool isAvailable() const { return available; }
+
+    /**
+     * スロット番号をキャッシュテクスチャに書き込む色へ変換
+     */
+    static sf::Color encode(int slot) {
+        return sf::Color(static_cast<sf::Uint8>(slot), 0, 0, 255);
+    }
+
+    /**
+     * スロットの実際の色を設定（値が変わった場合のみアップロード対象になる）
+     */
+    void setColor(int slot, const sf::Color& color);
+
+    // 変更されたスロットがあればテーブルをGPUへ転送
+    void upload();
+
+    const sf::Shader* getShader() const { return available ? shader.get() : nullptr; }
+
+    /**
+     * 縮小（LOD）生成用シェーダーを取得
+     * 2x2テクセルをそれぞれテーブルで色に変換してから平均する（インデックス同士は平均できないため）
+     * @param sourceSize 縮小元テクスチャのサイズ
+     */
+    const sf::Shader* getDownsampleShader(const sf::Vector2u& sourceSize);
+
+    bool hasDownsampleShader() const { return available && downsampleShader != nullptr; }
+
+    // 色が変わるたびに増加する番号（色を焼き込んだLODの再生成判定に使用）
+    uint64_t getColorVersion() const { return colorVersion; }
+
+private:
+    std::unique_ptr<sf::Shader> shader;
+    std::unique_ptr<sf::Shader> downsampleShader;
+    uint64_t colorVersion = 0;
+    sf::Texture lookupTexture;
+    std::array<sf::Uint8, SLOT_COUNT * 4> pixels{};
+    bool available = false;
+    bool needsUpload = true;
+};
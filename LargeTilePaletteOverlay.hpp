@@ -3,6 +3,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "LargeTileSystem.hpp"
+#include "UIHelper.hpp"
 
 /**
  * ^^CpbgI[o[C
@@ -25,6 +26,11 @@ private:
 
     std::vector<LargeTileRegion> largeTileRegions;
 
+    // `LbVi~܂ނsf::TrianglesAIςꍇ̂ݍĐj
+    mutable sf::VertexArray cachedVertices;
+    mutable bool cacheValid = false;
+    mutable int cachedSelectedLargeTile = -1;
+
 public:
     /**
      * RXgN^
@@ -121,29 +127,10 @@ public:
     void draw(sf::RenderWindow& window) const {
         if (!isVisible) return;
 
-        // I[o[Cwi
-        sf::RectangleShape overlay(sf::Vector2f(
-            tilesPerRow * (tileSize + 5) - 5,  // 4񕪂̕
-            16 * (tileSize + 5) - 5            // 16s̍
-        ));
-        overlay.setPosition(palettePosition);
-        overlay.setFillColor(sf::Color(0, 0, 0, 120));  // 
-        window.draw(overlay);
-
-        // e^^C̈`
-        for (const auto& region : largeTileRegions) {
-            drawLargeTileRegion(window, region);
-        }
-
-        // I𒆂̑^^CnCCg
-        if (selectedLargeTile >= 0) {
-            for (const auto& region : largeTileRegions) {
-                if (region.largeTileId == selectedLargeTile) {
-                    drawSelectionHighlight(window, region);
-                    break;
-                }
-            }
+        if (!cacheValid || cachedSelectedLargeTile != selectedLargeTile) {
+            buildVertices();
         }
+        window.draw(cachedVertices);
     }
 
     /**
@@ -174,10 +161,41 @@ private:
     }
 
     /**
-     * ^^C̈`
+     * I[o[CŚiwiEëEInCCgj̒_𐶐
+     */
+    void buildVertices() const {
+        cachedVertices.setPrimitiveType(sf::Triangles);
+        cachedVertices.clear();
+
+        // I[o[Cwi
+        appendQuad(cachedVertices, palettePosition.x, palettePosition.y,
+            tilesPerRow * (tileSize + 5) - 5,  // 4񕪂̕
+            16 * (tileSize + 5) - 5,           // 16s̍
+            sf::Color(0, 0, 0, 120));          // 
+
+        // e^^C̈
+        for (const auto& region : largeTileRegions) {
+            appendLargeTileRegion(region);
+        }
+
+        // I𒆂̑^^CnCCg
+        if (selectedLargeTile >= 0) {
+            for (const auto& region : largeTileRegions) {
+                if (region.largeTileId == selectedLargeTile) {
+                    appendSelectionHighlight(region);
+                    break;
+                }
+            }
+        }
+
+        cachedSelectedLargeTile = selectedLargeTile;
+        cacheValid = true;
+    }
+
+    /**
+     * ^^C̈̋EƔԍ}[J[ǉ
      */
-    void drawLargeTileRegion(sf::RenderWindow& window, const LargeTileRegion& region) const {
-        // ̈̋E`
+    void appendLargeTileRegion(const LargeTileRegion& region) const {
         float regionWidth = region.size.y * (tileSize + 5) - 5;
         float regionHeight = region.size.x * (tileSize + 5) - 5;
 
@@ -186,33 +204,23 @@ private:
             palettePosition.y + region.topLeft.x * (tileSize + 5)
         );
 
-        sf::RectangleShape regionRect(sf::Vector2f(regionWidth, regionHeight));
-        regionRect.setPosition(regionPos);
-        regionRect.setFillColor(sf::Color::Transparent);
-        regionRect.setOutlineThickness(2);
-        regionRect.setOutlineColor(sf::Color(255, 255, 0, 150));  // F
-        window.draw(regionRect);
-
-        // ^^Cԍ\
-        sf::CircleShape idMarker(8);
-        idMarker.setOrigin(8, 8);
-        idMarker.setPosition(
-            regionPos.x + regionWidth / 2,
-            regionPos.y + regionHeight / 2
-        );
-        idMarker.setFillColor(sf::Color(255, 0, 0, 180));
-        idMarker.setOutlineThickness(1);
-        idMarker.setOutlineColor(sf::Color::White);
-        window.draw(idMarker);
+        // ̈̋EiFj
+        appendOutline(cachedVertices, regionPos.x, regionPos.y, regionWidth, regionHeight, 2,
+            sf::Color(255, 255, 0, 150));
+
+        // ^^Cԍ̃}[J[
+        sf::Vector2f center(regionPos.x + regionWidth / 2, regionPos.y + regionHeight / 2);
+        appendCircle(cachedVertices, center, 8, sf::Color(255, 0, 0, 180));
+        appendCircleOutline(cachedVertices, center, 8, 1, sf::Color::White);
 
         // ԍeLXgiȗ - ۂɂsf::Textgpj
         // ɂ̓tHgKv
     }
 
     /**
-     * InCCg`
+     * InCCgǉ
      */
-    void drawSelectionHighlight(sf::RenderWindow& window, const LargeTileRegion& region) const {
+    void appendSelectionHighlight(const LargeTileRegion& region) const {
         float regionWidth = region.size.y * (tileSize + 5) - 5;
         float regionHeight = region.size.x * (tileSize + 5) - 5;
 
@@ -221,11 +229,9 @@ private:
             palettePosition.y + region.topLeft.x * (tileSize + 5)
         );
 
-        sf::RectangleShape highlight(sf::Vector2f(regionWidth, regionHeight));
-        highlight.setPosition(regionPos);
-        highlight.setFillColor(sf::Color(255, 255, 0, 80));  // FnCCg
-        highlight.setOutlineThickness(3);
-        highlight.setOutlineColor(sf::Color::Yellow);
-        window.draw(highlight);
+        appendQuad(cachedVertices, regionPos.x, regionPos.y, regionWidth, regionHeight,
+            sf::Color(255, 255, 0, 80));  // FnCCg
+        appendOutline(cachedVertices, regionPos.x, regionPos.y, regionWidth, regionHeight, 3,
+            sf::Color::Yellow);
     }
 };
\ No newline at end of file
@@ -21,6 +21,9 @@
 #include "GlobalColorPalette.hpp"
 #include "StartupDialog.hpp" // 新しく分離したStartupDialog
 #include "AppSettings.hpp" 
+#include "Benchmark.hpp"
+#include "TextCache.hpp"
+#include <cstdio>
 
 
 //#include <iostream>
@@ -146,19 +149,15 @@ void renderToolSpecificInfo(sf::RenderWindow& window, const sf::Font& font,
 // ユーティリティ関数
 void drawText(sf::RenderWindow& window, const sf::Font& font, const std::string& text,
     int fontSize, const sf::Vector2f& position, const sf::Color& color) {
-    sf::Text sfText(text, font, fontSize);
-    sfText.setPosition(position);
-    sfText.setFillColor(color);
-    window.draw(sfText);
+    TextCache::shared().draw(window, font, text, fontSize, position, color);
 }
 
 void drawRotationGuide(sf::RenderWindow& window, const sf::Font& font, int rotationDegrees) {
     if (rotationDegrees == 0) return;
 
-    sf::Text rotationText(std::to_string(rotationDegrees) + "°", font, 20);
-    rotationText.setPosition(WINDOW_WIDTH - 60, 20);
-    rotationText.setFillColor(sf::Color::Yellow);
-    window.draw(rotationText);
+    std::string degreesText = std::to_string(rotationDegrees);
+    TextCache::shared().drawFragments(window, font, 20, sf::Vector2f(WINDOW_WIDTH - 60, 20),
+        sf::Color::Yellow, { degreesText, "°" });
 }
 
 int main() {
@@ -203,8 +202,13 @@ int main() {
     //
 
 
+    // 大きなキャンバスは疎格納（描かれたチャンクのみメモリを確保）
+    const int SPARSE_CANVAS_TILES = 1024 * 1024;
+    const TileGrid::Storage canvasStorage = CANVAS_WIDTH * CANVAS_HEIGHT >= SPARSE_CANVAS_TILES ?
+        TileGrid::Storage::Sparse : TileGrid::Storage::Dense;
+
     //Canvas canvas(160, 160, 3, sf::Vector2f(360, 20));
-    Canvas canvas(CANVAS_WIDTH, CANVAS_HEIGHT, TILE_SIZE, sf::Vector2f(360, 20));
+    Canvas canvas(CANVAS_WIDTH, CANVAS_HEIGHT, TILE_SIZE, sf::Vector2f(360, 20), canvasStorage);
     CanvasView canvasView(sf::Vector2f(360, 20), window.getSize());
     DrawingManager drawingManager;
     UIManager uiManager(font);
@@ -247,66 +251,182 @@ int main() {
     sf::Color tileGridColor(0, 0, 0);
     int currentLargeTileId = 0;
 
-    // メインループ
-    while (window.isOpen()) {
-        sf::Event event;
-        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-        bool mousePressed = sf::Mouse::isButtonPressed(sf::Mouse::Left);
-
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
+    // フレームの再描画制御
+    // アイドル時は入力が来るまでブロックし、入力・ツール状態の変化があったフレームのみ描画する
+    const unsigned int DEFAULT_FRAME_LIMIT = 30;
+    const unsigned int HIGH_REFRESH_FRAME_LIMIT = 120;
+    bool frameDirty = true;
+    bool highRefresh = true;          // ストローク・パン中に高いフレームレートで更新（F8で切り替え）
+    unsigned int currentFrameLimit = DEFAULT_FRAME_LIMIT;
+    bool leftDragging = false;        // ウィンドウ内で左ボタンを押してから離すまで（スライダー・ツールのドラッグ）
+    bool cursorOnCanvas = false;      // 前回の描画でキャンバス上にカーソルを描いたか
+
+    // イベント1件の処理（表示が変わり得る入力のみ次のフレームを再描画対象にする）
+    auto processEvent = [&](const sf::Event& event) {
+        switch (event.type) {
+        case sf::Event::Resized:
+        case sf::Event::GainedFocus:
+        case sf::Event::MouseWheelScrolled:
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+        case sf::Event::KeyPressed:
+        case sf::Event::KeyReleased:   // F1押下中のデバッグ表示を消す
+            frameDirty = true;
+            break;
+        case sf::Event::MouseMoved: {
+            // ボタンのホバー表示か、キャンバス上のカーソル・プレビューが変わる場合のみ
+            sf::Vector2i movePos(event.mouseMove.x, event.mouseMove.y);
+            const bool hoverChanged = uiManager.updateButtons(movePos);
+            if (hoverChanged || cursorOnCanvas || canvas.containsInView(canvasView, movePos)) {
+                frameDirty = true;
             }
+            break;
+        }
+        case sf::Event::MouseLeft:
+            if (cursorOnCanvas) frameDirty = true;
+            break;
+        default:
+            break;
+        }
 
-            // ズーム・パン処理
-            if (event.type == sf::Event::MouseWheelScrolled) {
-                if (canvas.containsInView(canvasView, mousePos)) {
-                    canvasView.handleMouseWheel(event.mouseWheelScroll.delta, mousePos);
-                }
-            }
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        }
 
-            if (event.type == sf::Event::Resized) {
-                canvasView.updateWindowSize(sf::Vector2u(event.size.width, event.size.height));
+        // ズーム・パン処理
+        if (event.type == sf::Event::MouseWheelScrolled) {
+            sf::Vector2i wheelPos(event.mouseWheelScroll.x, event.mouseWheelScroll.y);
+            if (canvas.containsInView(canvasView, wheelPos)) {
+                canvasView.handleMouseWheel(event.mouseWheelScroll.delta, wheelPos);
             }
+        }
 
-            // マウスクリック処理
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i clickPos(event.mouseButton.x, event.mouseButton.y);
+        if (event.type == sf::Event::Resized) {
+            canvasView.updateWindowSize(sf::Vector2u(event.size.width, event.size.height));
+        }
 
-                // ボタン処理
-                handleButtonClicks(clickPos, uiManager, drawingManager, largeTilePaletteOverlay,
-                    largeTileManager, currentLargeTileId, brushSize, showGrid,
-                    tilePalette, patternGrid, colorPanel, canvas, canvasView,globalColorPalette);
+        // マウスクリック処理
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+            sf::Vector2i clickPos(event.mouseButton.x, event.mouseButton.y);
+            leftDragging = true;
 
-                // 描画開始
-                if (canvas.containsInView(canvasView, clickPos)) {
-                    drawingManager.startDrawing(clickPos, canvas, canvasView,
-                        tilePalette.getSelectedIndex(), brushSize);
-                }
-            }
+            // ボタン処理
+            handleButtonClicks(clickPos, uiManager, drawingManager, largeTilePaletteOverlay,
+                largeTileManager, currentLargeTileId, brushSize, showGrid,
+                tilePalette, patternGrid, colorPanel, canvas, canvasView,globalColorPalette);
 
-            // マウスリリース処理
-            if (event.type == sf::Event::MouseButtonReleased) {
-                if (event.mouseButton.button == sf::Mouse::Left && drawingManager.getIsDrawing()) {
-                    sf::Vector2i releasePos(event.mouseButton.x, event.mouseButton.y);
-                    drawingManager.stopDrawing(releasePos, canvas, canvasView,
-                        tilePalette.getSelectedIndex(), brushSize);
-                }
+            // 描画開始
+            if (canvas.containsInView(canvasView, clickPos)) {
+                drawingManager.startDrawing(clickPos, canvas, canvasView,
+                    tilePalette.getSelectedIndex(), brushSize);
             }
+        }
 
-            // 中ボタンパン処理
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Middle) {
-                isPanning = true;
-                lastPanPos = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+        // マウスリリース処理
+        if (event.type == sf::Event::MouseButtonReleased) {
+            if (event.mouseButton.button == sf::Mouse::Left) {
+                leftDragging = false;
             }
-
-            if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Middle) {
-                isPanning = false;
+            if (event.mouseButton.button == sf::Mouse::Left && drawingManager.getIsDrawing()) {
+                sf::Vector2i releasePos(event.mouseButton.x, event.mouseButton.y);
+                drawingManager.stopDrawing(releasePos, canvas, canvasView,
+                    tilePalette.getSelectedIndex(), brushSize);
             }
+        }
+
+        // 中ボタンパン処理
+        if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Middle) {
+            isPanning = true;
+            lastPanPos = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+        }
+
+        if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Middle) {
+            isPanning = false;
+        }
+
+        // ツール固有のキー操作（選択ツールのコピー・貼り付け等）を優先し、処理したキーは他へ渡さない
+        if (event.type == sf::Event::KeyPressed &&
+            drawingManager.handleKeyPressed(event.key, sf::Mouse::getPosition(window), canvas, canvasView,
+                tilePalette.getSelectedIndex())) {
+            return;
+        }
+
+        // キーボードショートカット
+        handleKeyboardInput(event, largeTileManager, currentLargeTileId, drawingManager);
+
+        // Oキーでブラシ形状（四角・丸）を切り替え
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::O) {
+            const bool round = drawingManager.getBrushShape() != BrushMask::Shape::Round;
+            drawingManager.setBrushShape(round ? BrushMask::Shape::Round : BrushMask::Shape::Square);
+            std::cout << "Brush shape: " << (round ? "Round" : "Square") << std::endl;
+        }
+
+        // Fキーで円・楕円ツールの塗りつぶしを切り替え
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F) {
+            drawingManager.setShapeFilled(!drawingManager.isShapeFilled());
+            std::cout << "Filled shapes: " << (drawingManager.isShapeFilled() ? "ON" : "OFF") << std::endl;
+        }
+
+        // [ / ] キーでブラシサイズを変更（1〜BrushMask::MAX_SIZE）
+        if (event.type == sf::Event::KeyPressed &&
+            (event.key.code == sf::Keyboard::LBracket || event.key.code == sf::Keyboard::RBracket)) {
+            brushSize = BrushMask::clampSize(brushSize + (event.key.code == sf::Keyboard::RBracket ? 1 : -1));
+            std::cout << "Brush size: " << brushSize << std::endl;
+        }
+
+        // F8キーでストローク・パン中の高フレームレート更新を切り替え
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F8) {
+            highRefresh = !highRefresh;
+            std::cout << "High refresh during strokes/pans: " << (highRefresh ? "ON" : "OFF") << std::endl;
+        }
+
+        // F9キーで画像出力のスレッド数別ベンチマーク（コンソール出力）
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F9) {
+            Benchmark::startExportScaling(canvas,
+                tilePalette.getSnapshot(globalColorPalette.getAllColors(), globalColorPalette.getColorVersion()));
+        }
 
-            // キーボードショートカット
-            handleKeyboardInput(event, largeTileManager, currentLargeTileId, drawingManager);
+        // F10キーでキャンバスサイズ別（512〜4096四方）のメモリ・処理時間ベンチマーク（コンソール出力）
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F10) {
+            Benchmark::startCanvasScaling(canvas,
+                tilePalette.getSnapshot(globalColorPalette.getAllColors(), globalColorPalette.getColorVersion()));
         }
+    };
+
+    // メインループ
+    while (window.isOpen()) {
+        sf::Event event;
+
+        // ウィンドウ外で離されて解放イベントが届かなかった場合はドラッグ終了とみなす
+        if (leftDragging && !sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
+            leftDragging = false;
+        }
+
+        // ストローク・パン・スライダー等のドラッグ中は入力がなくても毎フレーム更新
+        // （ウィンドウ内で始めたドラッグのみ。他のウィンドウでのクリックでは更新しない）
+        bool interacting = isPanning || drawingManager.getIsDrawing() || leftDragging;
+
+        if (!frameDirty && !interacting) {
+            // 再描画の必要がなければ次の入力まで待機（CPUを消費しない）
+            if (window.waitEvent(event)) {
+                processEvent(event);
+            }
+        }
+        while (window.pollEvent(event)) {
+            processEvent(event);
+        }
+        if (!window.isOpen()) break;
+
+        // ストローク・パン中のみ高いフレームレートで描画
+        bool strokeOrPan = isPanning || drawingManager.getIsDrawing();
+        unsigned int frameLimit = (highRefresh && strokeOrPan) ? HIGH_REFRESH_FRAME_LIMIT : DEFAULT_FRAME_LIMIT;
+        if (frameLimit != currentFrameLimit) {
+            window.setFramerateLimit(frameLimit);
+            currentFrameLimit = frameLimit;
+        }
+
+        sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+        bool mousePressed = sf::Mouse::isButtonPressed(sf::Mouse::Left);
 
         // 更新処理
         updateGameState(mousePos, mousePressed, isPanning, lastPanPos, canvasView,
@@ -314,13 +434,19 @@ int main() {
             uiManager, gridSpacing, gridShrink, tileGridColor,
             selectedColorIndex, patternChanged, brushSize,globalColorPalette);
 
-        // 描画処理
-        renderFrame(window, font, patternGrid, tilePalette, colorPanel, canvas, canvasView,
-            largeTilePaletteOverlay, drawingManager, uiManager, mousePos,
-            selectedColorIndex, brushSize, showGrid, gridSpacing, gridShrink,
-            tileGridColor, currentLargeTileId, largeTileManager, globalColorPalette);
+        // 描画処理（フレームレート制限はdisplay()で待機するため、連続更新中もCPUを占有しない）
+        if (frameDirty || interacting) {
+            renderFrame(window, font, patternGrid, tilePalette, colorPanel, canvas, canvasView,
+                largeTilePaletteOverlay, drawingManager, uiManager, mousePos,
+                selectedColorIndex, brushSize, showGrid, gridSpacing, gridShrink,
+                tileGridColor, currentLargeTileId, largeTileManager, globalColorPalette);
+            cursorOnCanvas = canvas.containsInView(canvasView, mousePos);
+            frameDirty = false;
+        }
     }
 
+    // 実行中のベンチマークを中断して終了を待つ
+    Benchmark::shutdown();
     return 0;
 }
 
@@ -359,7 +485,6 @@ void handleButtonClicks(const sf::Vector2i& clickPos, UIManager& uiManager,
 
             // タイルパレットの色セットも更新
             tilePalette.updateColorSet(tilePalette.getSelectedIndex(), colorPanel.getColorSet());
-            canvas.setDirty(true);
 
             std::cout << "Applied global color to current color slot in pattern" << std::endl;
         }
@@ -421,6 +546,15 @@ void handleButtonClicks(const sf::Vector2i& clickPos, UIManager& uiManager,
         }
     }
 
+    if (uiManager.getButton(ButtonIndex::TOOL_FILL).isClicked(clickPos, true)) {
+        drawingManager.setTool(ToolManager::ToolType::FILL);
+        largeTilePaletteOverlay.setVisible(false);
+    }
+    if (uiManager.getButton(ButtonIndex::TOOL_SELECT).isClicked(clickPos, true)) {
+        drawingManager.setTool(ToolManager::ToolType::SELECT);
+        largeTilePaletteOverlay.setVisible(false);
+    }
+
     // ビュー操作
     if (uiManager.getButton(ButtonIndex::RESET_VIEW).isClicked(clickPos, true)) {
         canvasView.reset();
@@ -541,19 +675,10 @@ void handleFileOperations(const sf::Vector2i& clickPos, UIManager& uiManager,
         const char* savePath = tinyfd_saveFileDialog("Save Project",  defaultName.c_str(), 0, nullptr, nullptr);
 
         if (savePath) {
-            // グローバルカラーインデックス配列を取得
-            std::vector<std::array<int, 3>> allGlobalColorIndices;
-            int patternCount = tilePalette.getPatternCount();
-            for (int i = 0; i < patternCount; ++i) {
-                allGlobalColorIndices.push_back(tilePalette.getGlobalColorIndices(i));
-            }
-
-            // 新しいグローバルカラー対応セーブ関数を使用
+            // 新しいグローバルカラー対応セーブ関数を使用（パレットはスナップショットを参照）
             saveProjectWithGlobalColors(savePath,
-                tilePalette.getAllPatterns(),
-                allGlobalColorIndices,
-                globalColorPalette.getAllColors(),
-                canvas.getTileIndices());
+                tilePalette.getSnapshot(globalColorPalette.getAllColors(), globalColorPalette.getColorVersion()),
+                canvas.getTiles());
 
             std::cout << "グローバルカラー形式で保存完了: " << savePath << std::endl;
         }
@@ -567,7 +692,7 @@ void handleFileOperations(const sf::Vector2i& clickPos, UIManager& uiManager,
             std::vector<std::array<sf::Color, 3>> colorSets;
             std::vector<std::array<int, 3>> globalColorIndices;
             std::array<sf::Color, 16> globalColors;
-            std::vector<std::vector<int>> tileData;
+            TileGrid tileData(0, 0, TileGrid::EMPTY, canvas.getTileStorage());
             bool isGlobalColorFormat;
 
             // 統合ロード関数を使用（新旧形式自動判別）
@@ -606,7 +731,7 @@ void handleFileOperations(const sf::Vector2i& clickPos, UIManager& uiManager,
                  //   tilePalette.loadPatterns(patterns, colorSets);
 
                     // キャンバスを復元
-                    canvas.setTileIndices(tileData);
+                    canvas.setTiles(std::move(tileData));
 
                     // 最初のパターンを選択
                     if (!patterns.empty()) {
@@ -638,7 +763,7 @@ void handleFileOperations(const sf::Vector2i& clickPos, UIManager& uiManager,
 
                     // 旧形式として読み込み（後方互換性）
                     tilePalette.loadPatterns(patterns, colorSets);
-                    canvas.setTileIndices(tileData);
+                    canvas.setTiles(std::move(tileData));
 
                     // 最初のパターンを選択
                     if (!patterns.empty()) {
@@ -700,19 +825,10 @@ void exportImage(TilePalette& tilePalette, Canvas& canvas, const std::string& fo
             }
         }
 
-        // グローバルカラーインデックス配列を取得
-        std::vector<std::array<int, 3>> allGlobalColorIndices;
-        int patternCount = tilePalette.getPatternCount();
-        for (int i = 0; i < patternCount; ++i) {
-            allGlobalColorIndices.push_back(tilePalette.getGlobalColorIndices(i));
-        }
-
-        // 新しいグローバルカラー対応の出力メソッドを使用
+        // 新しいグローバルカラー対応の出力メソッドを使用（パレットはスナップショットを参照）
         bool success = canvas.exportToImageWithGlobalColors(
             savePath,
-            tilePalette.getAllPatterns(),
-            allGlobalColorIndices,
-            globalColorPalette.getAllColors(),
+            tilePalette.getSnapshot(globalColorPalette.getAllColors(), globalColorPalette.getColorVersion()),
             false, // グリッド線は出力しない
             0.0f, 1.0f
         );
@@ -762,6 +878,15 @@ void handleKeyboardInput(const sf::Event& event, LargeTileManager& largeTileMana
     if (event.key.code == sf::Keyboard::W) {
         selectLargeTile(largeTileManager, drawingManager, currentLargeTileId, 11);
     }
+
+    // 塗りつぶしツール選択中：Cキーで4/8近傍、Aキーで全体置き換えを切り替え
+    if (drawingManager.getCurrentToolType() == ToolManager::ToolType::FILL) {
+        bool eightConnected = drawingManager.isFillEightConnected();
+        bool replaceAll = drawingManager.isFillReplaceAll();
+        if (event.key.code == sf::Keyboard::C) eightConnected = !eightConnected;
+        if (event.key.code == sf::Keyboard::A) replaceAll = !replaceAll;
+        drawingManager.setFillOptions(eightConnected, replaceAll);
+    }
 }
 
 /**
@@ -829,7 +954,6 @@ void updateGameState(const sf::Vector2i& mousePos, bool mousePressed, bool& isPa
     // カラーパネル更新
     if (colorSliderChanged && tilePalette.getSelectedIndex() >= 0) {
         tilePalette.updateColorSet(tilePalette.getSelectedIndex(), colorPanel.getColorSet());
-        canvas.notifyDataChanged(); //　キャンバスのデータが変更されたことを通知
 
         // RGBスライダーで色が変更された場合の処理
         //現在編集中の色をグローバルカラーパレットに反映
@@ -870,9 +994,8 @@ void updateGameState(const sf::Vector2i& mousePos, bool mousePressed, bool& isPa
 
     // パターン変更処理
     if (patternChanged && tilePalette.getSelectedIndex() >= 0) {
+        // キャンバスへの反映はパレットのバージョン番号で自動的に検知される
         tilePalette.updatePattern(tilePalette.getSelectedIndex(), patternGrid.getTiles());
-        //canvas.setDirty(true);
-        canvas.notifyDataChanged(); // キャンバスのデータが変更されたことを通知
         patternChanged = false;
     }
 
@@ -922,18 +1045,10 @@ void renderFrame(sf::RenderWindow& window, const sf::Font& font, PatternGrid& pa
     globalColorPalette.draw(window);
 
     // キャンバス描画（グローバルカラー使用）
-    // TilePaletteからグローバルカラーインデックス配列を取得
-    std::vector<std::array<int, 3>> allGlobalColorIndices;
-    int patternCount = tilePalette.getPatternCount();
-    for (int i = 0; i < patternCount; ++i) {
-        allGlobalColorIndices.push_back(tilePalette.getGlobalColorIndices(i));
-    }
-
-    // 新しいグローバルカラー対応メソッドを使用
-    canvas.drawWithViewAndGlobalColors(window, canvasView,
-        tilePalette.getAllPatterns(),
-        allGlobalColorIndices,
-        globalColorPalette.getAllColors(),
+    // パレットのスナップショットは変更があった部分のみ更新され、毎フレームの複製は発生しない
+    const PaletteSnapshot& palette =
+        tilePalette.getSnapshot(globalColorPalette.getAllColors(), globalColorPalette.getColorVersion());
+    canvas.drawWithViewAndGlobalColors(window, canvasView, palette,
         showGrid, gridSpacing, gridShrink);
 
     // UI描画
@@ -946,6 +1061,10 @@ void renderFrame(sf::RenderWindow& window, const sf::Font& font, PatternGrid& pa
         drawingManager.drawCursor(window, mousePos, canvasView, brushSize, canvas.getTileSize());
         drawingManager.drawPreview(window, mousePos, canvasView, brushSize);
     }
+    else if (drawingManager.hasPersistentPreview()) {
+        // 選択範囲の枠はマウスがキャンバス外にあっても表示
+        drawingManager.drawPreview(window, mousePos, canvasView, brushSize);
+    }
 
     window.display();
 }
@@ -960,23 +1079,38 @@ void renderInfoText(sf::RenderWindow& window, const sf::Font& font, CanvasView&
     int selectedColorIndex, TilePalette& tilePalette, Canvas& canvas,
     GlobalColorPalette& globalColorPalette) {
 
-    // ズーム情報
-    drawText(window, font, canvasView.getStatusString(),
-        14, sf::Vector2f(20, 20), sf::Color::Cyan);
+    // 状態表示は固定の見出しと変化する数値の断片に分けて描画（数値の変化で見出しを作り直さない）
+    TextCache& textCache = TextCache::shared();
+
+    // ズーム情報（CanvasView::getStatusString と同じ書式）
+    char zoomText[32];
+    std::snprintf(zoomText, sizeof(zoomText), "%.1f", canvasView.getZoom() * 100.0f);
+    sf::Vector2f panOffset = canvasView.getPanOffset();
+    std::string panX = std::to_string(static_cast<int>(panOffset.x));
+    std::string panY = std::to_string(static_cast<int>(panOffset.y));
+    textCache.drawFragments(window, font, 14, sf::Vector2f(20, 20), sf::Color::Cyan,
+        { "Zoom: ", zoomText, "% | Pan: (", panX, ", ", panY, ")" });
 
     // ツール情報
-    std::string toolInfo = "Tool: " + drawingManager.getCurrentToolName();
+    std::string toolName = drawingManager.getCurrentToolName();
     if (drawingManager.getCurrentToolType() == ToolManager::ToolType::LARGE_TILE) {
         int rotationDegrees = largeTileManager.getCurrentRotationDegrees();
-        toolInfo += " [" + std::to_string(currentLargeTileId) + "]";
+        std::string tileIdText = std::to_string(currentLargeTileId);
         if (rotationDegrees != 0) {
-            toolInfo += " " + std::to_string(rotationDegrees) + "°";
+            std::string degreesText = std::to_string(rotationDegrees);
+            textCache.drawFragments(window, font, 14, sf::Vector2f(20, 40), sf::Color::Yellow,
+                { "Tool: ", toolName, " [", tileIdText, "] ", degreesText, "°" });
+        }
+        else {
+            textCache.drawFragments(window, font, 14, sf::Vector2f(20, 40), sf::Color::Yellow,
+                { "Tool: ", toolName, " [", tileIdText, "]" });
         }
     }
     else {
-        toolInfo += " | Brush Size: " + std::to_string(brushSize);
+        std::string brushSizeText = std::to_string(brushSize);
+        textCache.drawFragments(window, font, 14, sf::Vector2f(20, 40), sf::Color::Yellow,
+            { "Tool: ", toolName, " | Brush Size: ", brushSizeText });
     }
-    drawText(window, font, toolInfo, 14, sf::Vector2f(20, 40), sf::Color::Yellow);
 
     // 操作説明
     drawText(window, font, "Mouse Wheel: Zoom | Middle Drag: Pan | Left Click: Draw",
@@ -986,12 +1120,14 @@ void renderInfoText(sf::RenderWindow& window, const sf::Font& font, CanvasView&
     renderToolSpecificInfo(window, font, drawingManager, largeTileManager, currentLargeTileId);
 
     // ステータス情報
-    drawText(window, font, "Selected Color: " + std::to_string(selectedColorIndex),
-        14, sf::Vector2f(20, 840), sf::Color::White);
+    std::string colorIndexText = std::to_string(selectedColorIndex);
+    textCache.drawFragments(window, font, 14, sf::Vector2f(20, 840), sf::Color::White,
+        { "Selected Color: ", colorIndexText });
 
     if (tilePalette.getSelectedIndex() >= 0) {
-        drawText(window, font, "Selected Tile: " + std::to_string(tilePalette.getSelectedIndex()),
-            14, sf::Vector2f(20, 860), sf::Color::White);
+        std::string tileIndexText = std::to_string(tilePalette.getSelectedIndex());
+        textCache.drawFragments(window, font, 14, sf::Vector2f(20, 860), sf::Color::White,
+            { "Selected Tile: ", tileIndexText });
     }
     else {
         drawText(window, font, "No Tile Selected", 14, sf::Vector2f(20, 860), sf::Color::White);
@@ -999,26 +1135,28 @@ void renderInfoText(sf::RenderWindow& window, const sf::Font& font, CanvasView&
 
     // キャンバス情報
     auto canvasSize = canvas.getCanvasPixelSize();
-    std::string canvasInfo = "Canvas: " + std::to_string(canvasSize.first) + "x" +
-        std::to_string(canvasSize.second) + " px";
-    drawText(window, font, canvasInfo, 14, sf::Vector2f(20, 820), sf::Color(200, 200, 200));
+    std::string canvasWidthText = std::to_string(canvasSize.first);
+    std::string canvasHeightText = std::to_string(canvasSize.second);
+    textCache.drawFragments(window, font, 14, sf::Vector2f(20, 820), sf::Color(200, 200, 200),
+        { "Canvas: ", canvasWidthText, "x", canvasHeightText, " px" });
 
     // デバッグ情報（F1キー押下時）
     if (sf::Keyboard::isKeyPressed(sf::Keyboard::F1)) {
         auto stats = drawingManager.getDrawingStats();
-        std::string debugInfo = "Drawing: " + std::string(stats.isDrawing ? "YES" : "NO") +
-            " | Moved: " + std::string(stats.hasMoved ? "YES" : "NO");
-        drawText(window, font, debugInfo, 12, sf::Vector2f(20, 100), sf::Color::Green);
+        textCache.drawFragments(window, font, 12, sf::Vector2f(20, 100), sf::Color::Green,
+            { "Drawing: ", stats.isDrawing ? "YES" : "NO", " | Moved: ", stats.hasMoved ? "YES" : "NO" });
     }
 
 
     // GlobalColorPalette情報を追加
     int globalColorIndex = globalColorPalette.getSelectedIndex();
     sf::Color globalColor = globalColorPalette.getSelectedColor();
-    std::string globalColorInfo = "Global Color: [" + std::to_string(globalColorIndex) + "] RGB(" +
-        std::to_string((int)globalColor.r) + ", " + std::to_string((int)globalColor.g) + ", " +
-        std::to_string((int)globalColor.b) + ")";
-    drawText(window, font, globalColorInfo, 14, sf::Vector2f(20, 800), sf::Color(100, 255, 100));
+    std::string globalIndexText = std::to_string(globalColorIndex);
+    std::string redText = std::to_string((int)globalColor.r);
+    std::string greenText = std::to_string((int)globalColor.g);
+    std::string blueText = std::to_string((int)globalColor.b);
+    textCache.drawFragments(window, font, 14, sf::Vector2f(20, 800), sf::Color(100, 255, 100),
+        { "Global Color: [", globalIndexText, "] RGB(", redText, ", ", greenText, ", ", blueText, ")" });
 
 }
 
@@ -1031,9 +1169,9 @@ void renderToolSpecificInfo(sf::RenderWindow& window, const sf::Font& font,
     auto toolType = drawingManager.getCurrentToolType();
 
     if (toolType == ToolManager::ToolType::LARGE_TILE) {
-        std::string largeTileInfo = "Large Tile: 0-9,Q,W keys to select | Current: " +
-            std::to_string(currentLargeTileId);
-        drawText(window, font, largeTileInfo, 12, sf::Vector2f(20, 80), sf::Color(255, 200, 100));
+        std::string tileIdText = std::to_string(currentLargeTileId);
+        TextCache::shared().drawFragments(window, font, 12, sf::Vector2f(20, 80), sf::Color(255, 200, 100),
+            { "Large Tile: 0-9,Q,W keys to select | Current: ", tileIdText });
         drawRotationGuide(window, font, largeTileManager.getCurrentRotationDegrees());
     }
     else if (toolType == ToolManager::ToolType::LINE) {
@@ -1048,4 +1186,21 @@ void renderToolSpecificInfo(sf::RenderWindow& window, const sf::Font& font,
         drawText(window, font, "Ellipse Tool: Click and drag diagonal to draw ellipse",
             12, sf::Vector2f(20, 80), sf::Color(255, 200, 100));
     }
+    else if (toolType == ToolManager::ToolType::FILL) {
+        TextCache::shared().drawFragments(window, font, 12, sf::Vector2f(20, 80), sf::Color(255, 200, 100),
+            { "Fill Tool: Click to fill | C: ", drawingManager.isFillEightConnected() ? "8-connected" : "4-connected",
+              " | A: Replace all ", drawingManager.isFillReplaceAll() ? "ON" : "OFF" });
+    }
+    else if (toolType == ToolManager::ToolType::SELECT) {
+        if (auto* selectionTool = dynamic_cast<SelectionTool*>(drawingManager.getCurrentTool())) {
+            const sf::IntRect& selection = selectionTool->getSelection();
+            const TileBlock& clipboard = selectionTool->getClipboard();
+            TextCache::shared().drawFragments(window, font, 12, sf::Vector2f(20, 80), sf::Color(255, 200, 100),
+                { "Select: ", std::to_string(selection.width), "x", std::to_string(selection.height),
+                  " | Clip: ", std::to_string(clipboard.width), "x", std::to_string(clipboard.height),
+                  *selectionTool->getLastAction() ? " | " : "", selectionTool->getLastAction() });
+            drawText(window, font, "Ctrl+C/X/V, Del, Enter: Fill, H/V: Flip, T: Rotate",
+                12, sf::Vector2f(20, 94), sf::Color(255, 200, 100));
+        }
+    }
 }
\ No newline at end of file
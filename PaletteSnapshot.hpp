@@ -0,0 +1,76 @@
+﻿//===== PaletteSnapshot.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <array>
+#include <cstdint>
+
+/**
+ * パレットの平坦なスナップショット
+ * パターンスロットごとのセル・グローバルカラーインデックス・解決済みの色を、
+ * 種類ごとに1本の連続した配列として保持する（スロット p の各データは同じ添字 p）
+ * TilePalette::getSnapshot が内容の変わった配列だけを更新し、描画・画像出力・保存は
+ * const 参照で読むだけなので毎フレームの複製・メモリ確保が発生しない
+ */
+struct PaletteSnapshot {
+    static constexpr int CELL_COUNT = 9;    // 3x3セル
+    static constexpr int GLOBAL_COLOR_COUNT = 16;
+
+    using Cells = std::array<int, CELL_COUNT>;
+    using ColorIndices = std::array<int, 3>;
+    using ColorSet = std::array<sf::Color, 3>;
+
+    std::vector<Cells> cells;               // セルの色番号（0-2、9セルに満たないパターンは全て-1）
+    std::vector<ColorIndices> colorIndices; // 参照するグローバルカラーのインデックス
+    std::vector<ColorSet> colors;           // 解決済みのRGBA
+    std::array<sf::Color, GLOBAL_COLOR_COUNT> globalColors; // 解決に使ったグローバルカラー
+
+    // 生成元のバージョン番号（TilePalette / GlobalColorPalette のカウンタ）
+    uint64_t patternVersion = 0;
+    uint64_t colorIndexVersion = 0;
+    uint64_t colorVersion = 0;
+
+    int getPatternCount() const { return static_cast<int>(cells.size()); }
+
+    /**
+     * 可変長のパターン配列を固定長のセル配列に詰める
+     * 要素数が変わらない限り既存の領域を再利用する
+     */
+    static void packCells(const std::vector<std::vector<int>>& patterns, std::vector<Cells>& out) {
+        out.resize(patterns.size());
+        for (std::size_t p = 0; p < patterns.size(); ++p) {
+            const std::vector<int>& pattern = patterns[p];
+            for (int i = 0; i < CELL_COUNT; ++i) {
+                out[p][i] = pattern.size() >= CELL_COUNT ? pattern[i] : -1;
+            }
+        }
+    }
+
+    /**
+     * グローバルカラーインデックスを実際の色に変換（範囲外は黒）
+     */
+    static void resolveColors(const std::vector<ColorIndices>& indices,
+        const std::array<sf::Color, GLOBAL_COLOR_COUNT>& globalColors, std::vector<ColorSet>& out) {
+        out.resize(indices.size());
+        for (std::size_t p = 0; p < indices.size(); ++p) {
+            for (int i = 0; i < 3; ++i) {
+                int globalIndex = indices[p][i];
+                out[p][i] = (globalIndex >= 0 && globalIndex < GLOBAL_COLOR_COUNT) ?
+                    globalColors[globalIndex] : sf::Color::Black; // フォールバック
+            }
+        }
+    }
+
+    /**
+     * 個別の配列からスナップショット全体を作り直す（旧形式のAPIからの変換用）
+     */
+    void assign(const std::vector<std::vector<int>>& patterns,
+        const std::vector<ColorIndices>& indices,
+        const std::array<sf::Color, GLOBAL_COLOR_COUNT>& colors16) {
+        packCells(patterns, cells);
+        colorIndices.assign(indices.begin(), indices.end());
+        colorIndices.resize(cells.size(), ColorIndices{ 0, 1, 2 });
+        globalColors = colors16;
+        resolveColors(colorIndices, globalColors, colors);
+    }
+};
@@ -0,0 +1,142 @@
+﻿#include "PatternAtlas.hpp"
+#include <iostream>
+#include <algorithm>
+
+namespace {
+    // 軸平行な矩形をQuadとして追加
+    inline void appendQuad(sf::VertexArray& vertices, float left, float top,
+        float w, float h, const sf::Color& color) {
+        vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left + w, top), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left + w, top + h), color));
+        vertices.append(sf::Vertex(sf::Vector2f(left, top + h), color));
+    }
+}
+
+bool PatternAtlas::createTexture(int tileSize) {
+    int rows = (MAX_SLOTS + COLUMNS - 1) / COLUMNS;
+    texture = std::make_unique<sf::RenderTexture>();
+    if (!texture->create(COLUMNS * tileSize, rows * tileSize)) {
+        std::cerr << "Error: Failed to create pattern atlas texture" << std::endl;
+        texture.reset();
+        return false;
+    }
+    texture->clear(sf::Color::Transparent);
+    return true;
+}
+
+uint64_t PatternAtlas::update(const std::vector<std::array<int, 9>>& cells,
+    const std::vector<std::array<sf::Color, 3>>& colorSets,
+    const Settings& settings) {
+
+    bool regenerateAll = false;
+    if (!texture || settings.tileSize != currentSettings.tileSize) {
+        if (!createTexture(settings.tileSize)) return 0;
+        regenerateAll = true;
+    }
+    if (settings != currentSettings) {
+        currentSettings = settings;
+        regenerateAll = true;
+    }
+
+    slotCount = static_cast<int>(std::min({ cells.size(), colorSets.size(),
+        static_cast<std::size_t>(MAX_SLOTS) }));
+
+    uint64_t changed = 0;
+    for (int slot = 0; slot < MAX_SLOTS; ++slot) {
+        SlotKey key;
+        if (slot < slotCount) {
+            key.used = true;
+            key.cells = cells[slot];
+            key.colors = colorSets[slot];
+        }
+
+        if (regenerateAll || key != slotKeys[slot]) {
+            renderSlot(slot, key);
+            slotKeys[slot] = key;
+            changed |= (uint64_t(1) << slot);
+        }
+    }
+
+    if (changed) {
+        texture->display();
+    }
+    return changed;
+}
+
+void PatternAtlas::renderSlot(int slot, const SlotKey& key) {
+    const int tileSize = currentSettings.tileSize;
+    const float left = static_cast<float>((slot % COLUMNS) * tileSize);
+    const float top = static_cast<float>((slot / COLUMNS) * tileSize);
+
+    // スロット領域を透明で上書き（ブレンドなし）
+    slotVertices.setPrimitiveType(sf::Quads);
+    slotVertices.clear();
+    appendQuad(slotVertices, left, top, tileSize, tileSize, sf::Color::Transparent);
+    texture->draw(slotVertices, sf::RenderStates(sf::BlendNone));
+
+    if (!key.used) return;
+
+    slotVertices.clear();
+    appendTileGeometry(slotVertices, left, top, key.cells, key.colors, currentSettings);
+    texture->draw(slotVertices);
+}
+
+void PatternAtlas::appendTileQuad(sf::VertexArray& vertices, float left, float top, int slot) const {
+    const float tileSize = static_cast<float>(currentSettings.tileSize);
+    const float u = (slot % COLUMNS) * tileSize;
+    const float v = (slot / COLUMNS) * tileSize;
+
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), sf::Vector2f(u, v)));
+    vertices.append(sf::Vertex(sf::Vector2f(left + tileSize, top), sf::Vector2f(u + tileSize, v)));
+    vertices.append(sf::Vertex(sf::Vector2f(left + tileSize, top + tileSize), sf::Vector2f(u + tileSize, v + tileSize)));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top + tileSize), sf::Vector2f(u, v + tileSize)));
+}
+
+void PatternAtlas::appendTileGeometry(sf::VertexArray& vertices, float originX, float originY,
+    const std::array<int, 9>& cells, const std::array<sf::Color, 3>& colorSet,
+    const Settings& settings) {
+
+    const int tileSize = settings.tileSize;
+
+    if (settings.useTileGridColor && settings.spacing > 0.0f) {
+        // タイル全体の領域をタイル内部グリッド色で塗りつぶし
+        appendQuad(vertices, originX, originY, tileSize, tileSize, settings.tileGridColor);
+
+        // 内側の描画領域を計算（spacing分だけ内側に）
+        float borderWidth = tileSize * settings.spacing * 0.5f;
+        float innerTileSize = tileSize - (borderWidth * 2);
+        float innerCellSize = innerTileSize / 3.0f;
+
+        float adjustedCellSize = innerCellSize * settings.shrink;
+        float cellCenterOffset = (innerCellSize - adjustedCellSize) * 0.5f;
+        for (int cy = 0; cy < 3; ++cy) {
+            for (int cx = 0; cx < 3; ++cx) {
+                int colorIndex = cells[cy * 3 + cx];
+                if (colorIndex >= 0 && colorIndex < 3) {
+                    appendQuad(vertices,
+                        originX + borderWidth + cx * innerCellSize + cellCenterOffset,
+                        originY + borderWidth + cy * innerCellSize + cellCenterOffset,
+                        adjustedCellSize, adjustedCellSize, colorSet[colorIndex]);
+                }
+            }
+        }
+    }
+    else {
+        // spacing = 0 の場合は従来通りの描画
+        float cellSize = tileSize / 3.0f;
+        float adjustedCellSize = cellSize * settings.shrink;
+        float cellCenterOffset = (cellSize - adjustedCellSize) * 0.5f;
+        for (int cy = 0; cy < 3; ++cy) {
+            for (int cx = 0; cx < 3; ++cx) {
+                int colorIndex = cells[cy * 3 + cx];
+                if (colorIndex >= 0 && colorIndex < 3) {
+                    appendQuad(vertices,
+                        originX + cx * cellSize + cellCenterOffset,
+                        originY + cy * cellSize + cellCenterOffset,
+                        adjustedCellSize, adjustedCellSize, colorSet[colorIndex]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+﻿//===== PatternAtlas.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+
+/**
+ * パターンスタンプアトラス
+ * パレットの各パターン（最大64個）を現在の描画設定で1度だけタイルサイズに描画して保持する
+ * キャンバス側は1タイルにつき1枚のテクスチャ付きQuadで描画できる
+ */
+class PatternAtlas {
+public:
+    static constexpr int MAX_SLOTS = 64;   // TilePalette::maxTiles と同じ
+    static constexpr int COLUMNS = 8;      // アトラスの横方向スロット数
+
+    /**
+     * スロット描画に影響する設定
+     * いずれかが変わった場合は全スロットを再生成する
+     */
+    struct Settings {
+        int tileSize = 0;
+        float spacing = 0.0f;
+        float shrink = 1.0f;
+        bool useTileGridColor = true;
+        sf::Color tileGridColor = sf::Color(128, 128, 128);
+
+        bool operator==(const Settings& other) const {
+            return tileSize == other.tileSize && spacing == other.spacing &&
+                shrink == other.shrink && useTileGridColor == other.useTileGridColor &&
+                tileGridColor == other.tileGridColor;
+        }
+        bool operator!=(const Settings& other) const { return !(*this == other); }
+    };
+
+    /**
+     * 変更のあったスロットのみ再生成
+     * @param cells パターンごとの3x3セル（PaletteSnapshot::cells）
+     * @param colorSets パターンごとの3色
+     * @param settings 描画設定
+     * @return 再生成したスロットのビットマスク（bit i = スロット i）
+     */
+    uint64_t update(const std::vector<std::array<int, 9>>& cells,
+        const std::vector<std::array<sf::Color, 3>>& colorSets,
+        const Settings& settings);
+
+    bool isReady() const { return texture != nullptr; }
+
+    const sf::Texture& getTexture() const { return texture->getTexture(); }
+
+    // 描画可能なスロット数（パターン数と色数の小さい方、最大 MAX_SLOTS）
+    int getSlotCount() const { return slotCount; }
+
+    /**
+     * 指定スロットを参照するテクスチャ付きQuadを追加
+     * @param vertices 追加先の頂点配列（sf::Quads）
+     * @param left タイル左上のX座標
+     * @param top タイル左上のY座標
+     * @param slot スロット番号（パターンインデックス）
+     */
+    void appendTileQuad(sf::VertexArray& vertices, float left, float top, int slot) const;
+
+    /**
+     * 1タイル分の背景とセルを単色Quadとして頂点配列へ追加
+     * @param cells 3x3セルの色番号（0-2、範囲外は透明）
+     */
+    static void appendTileGeometry(sf::VertexArray& vertices, float originX, float originY,
+        const std::array<int, 9>& cells, const std::array<sf::Color, 3>& colorSet,
+        const Settings& settings);
+
+private:
+    // スロットの内容を決めるキー（前回生成時との比較用）
+    struct SlotKey {
+        bool used = false;
+        std::array<int, 9> cells{};
+        std::array<sf::Color, 3> colors;
+
+        bool operator==(const SlotKey& other) const {
+            return used == other.used && cells == other.cells && colors == other.colors;
+        }
+        bool operator!=(const SlotKey& other) const { return !(*this == other); }
+    };
+
+    std::unique_ptr<sf::RenderTexture> texture;
+    Settings currentSettings;
+    std::array<SlotKey, MAX_SLOTS> slotKeys;
+    int slotCount = 0;
+    sf::VertexArray slotVertices;
+
+    bool createTexture(int tileSize);
+    void renderSlot(int slot, const SlotKey& key);
+};
@@ -1,5 +1,6 @@
 ﻿// PatternGrid.cpp
 #include "PatternGrid.hpp"
+#include "UIHelper.hpp"
 
 PatternGrid::PatternGrid(int rows, int cols, int tileSize)
     : rows(rows), cols(cols), tileSize(tileSize), position(20.f, 20.f) {
@@ -9,15 +10,21 @@ PatternGrid::PatternGrid(int rows, int cols, int tileSize)
 
 
 void PatternGrid::draw(sf::RenderWindow& window, const std::array<sf::Color, 3>& colorSet) {
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            sf::RectangleShape rect(sf::Vector2f(tileSize - 2, tileSize - 2)); // 2pxŒ„ŠÔ
-            rect.setPosition(position.x + x * tileSize, position.y + y * tileSize);
-            rect.setFillColor(colorSet[tiles[y][x]]);
-            window.draw(rect);
+    if (!cacheValid || cachedColorSet != colorSet) {
+        cachedVertices.setPrimitiveType(sf::Quads);
+        cachedVertices.clear();
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                int colorIndex = tiles[y][x];
+                if (colorIndex < 0 || colorIndex >= 3) continue;
+                appendQuad(cachedVertices, position.x + x * tileSize, position.y + y * tileSize,
+                    tileSize - 2, tileSize - 2, colorSet[colorIndex]); // 2px隙間
+            }
         }
-
+        cachedColorSet = colorSet;
+        cacheValid = true;
     }
+    window.draw(cachedVertices);
 }
 
 bool PatternGrid::handleClick(const sf::Vector2i& mousePos, int selectedColor) {
@@ -29,6 +36,7 @@ bool PatternGrid::handleClick(const sf::Vector2i& mousePos, int selectedColor) {
     if (x >= 0 && x < cols && y >= 0 && y < rows) {
         if (tiles[y][x] != selectedColor) {
             tiles[y][x] = selectedColor;
+            cacheValid = false;
             return true;
         }
     }
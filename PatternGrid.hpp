@@ -19,11 +19,13 @@ public:
     void setTiles(const std::vector<std::vector<int>>& newTiles) {
         if (newTiles.size() == tiles.size() && newTiles[0].size() == tiles[0].size()) {
             tiles = newTiles;
+            cacheValid = false;
         }
     }
 
     void setPosition(const sf::Vector2f& pos) {
         this->position = pos;
+        cacheValid = false;
     }
 
     // 新しいメソッド：グローバルカラーから3色を取得して描画
@@ -47,4 +49,9 @@ private:
     int rows, cols, tileSize;
     std::vector<std::vector<int>> tiles; // 色インデックス（0〜2）
     sf::Vector2f position;               // 左上位置
+
+    // 描画キャッシュ（セルの値・色・位置が変わった場合のみ再生成）
+    sf::VertexArray cachedVertices;
+    bool cacheValid = false;
+    std::array<sf::Color, 3> cachedColorSet;
 };
\ No newline at end of file
@@ -0,0 +1,282 @@
+﻿#include "PngStreamWriter.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+    const sf::Uint8 PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+    // deflateの長さ符号（符号 257-285）の基準値と拡張ビット数
+    const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+    const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+
+    const int MIN_MATCH = 3;
+    const int MAX_MATCH = 258;
+
+    void appendUint32(std::vector<sf::Uint8>& out, uint32_t value) {
+        out.push_back(static_cast<sf::Uint8>(value >> 24));
+        out.push_back(static_cast<sf::Uint8>(value >> 16));
+        out.push_back(static_cast<sf::Uint8>(value >> 8));
+        out.push_back(static_cast<sf::Uint8>(value));
+    }
+
+    const std::array<uint32_t, 256>& getCrcTable() {
+        static const std::array<uint32_t, 256> table = []() {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t n = 0; n < 256; ++n) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                t[n] = c;
+            }
+            return t;
+        }();
+        return table;
+    }
+}
+
+uint32_t PngStreamWriter::crc32(uint32_t crc, const sf::Uint8* data, std::size_t size) {
+    const auto& table = getCrcTable();
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void PngStreamWriter::writeChunk(const char* type, const sf::Uint8* data, std::size_t size) {
+    sf::Uint8 header[8] = {
+        static_cast<sf::Uint8>(size >> 24), static_cast<sf::Uint8>(size >> 16),
+        static_cast<sf::Uint8>(size >> 8), static_cast<sf::Uint8>(size),
+        static_cast<sf::Uint8>(type[0]), static_cast<sf::Uint8>(type[1]),
+        static_cast<sf::Uint8>(type[2]), static_cast<sf::Uint8>(type[3]) };
+
+    uint32_t crc = crc32(0xFFFFFFFFu, header + 4, 4);
+    crc = crc32(crc, data, size) ^ 0xFFFFFFFFu;
+    sf::Uint8 footer[4] = {
+        static_cast<sf::Uint8>(crc >> 24), static_cast<sf::Uint8>(crc >> 16),
+        static_cast<sf::Uint8>(crc >> 8), static_cast<sf::Uint8>(crc) };
+
+    file.write(reinterpret_cast<const char*>(header), 8);
+    if (size > 0) {
+        file.write(reinterpret_cast<const char*>(data), size);
+    }
+    file.write(reinterpret_cast<const char*>(footer), 4);
+    if (!file) failed = true;
+}
+
+void PngStreamWriter::flushIdat(bool force) {
+    while (idatBuffer.size() >= IDAT_CHUNK_SIZE || (force && !idatBuffer.empty())) {
+        std::size_t size = std::min(idatBuffer.size(), IDAT_CHUNK_SIZE);
+        writeChunk("IDAT", idatBuffer.data(), size);
+        idatBuffer.erase(idatBuffer.begin(), idatBuffer.begin() + size);
+    }
+}
+
+bool PngStreamWriter::open(const std::string& filename, unsigned imageWidth, unsigned imageHeight) {
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Failed to create PNG file: " << filename << std::endl;
+        return false;
+    }
+
+    width = imageWidth;
+    height = imageHeight;
+    rowsWritten = 0;
+    rowBytes = static_cast<std::size_t>(width) * 4;
+    failed = false;
+    bitBuffer = 0;
+    bitCount = 0;
+    adlerA = 1;
+    adlerB = 0;
+    idatBuffer.clear();
+    idatBuffer.reserve(IDAT_CHUNK_SIZE * 2);
+
+    previousRow.assign(rowBytes, 0);
+    for (auto& candidate : filterCandidates) {
+        candidate.resize(rowBytes + 1);
+    }
+
+    file.write(reinterpret_cast<const char*>(PNG_SIGNATURE), 8);
+
+    // IHDR：RGBA 8bit、インターレースなし
+    std::vector<sf::Uint8> ihdr;
+    appendUint32(ihdr, width);
+    appendUint32(ihdr, height);
+    ihdr.push_back(8);  // ビット深度
+    ihdr.push_back(6);  // カラータイプ：RGBA
+    ihdr.push_back(0);  // 圧縮方式
+    ihdr.push_back(0);  // フィルタ方式
+    ihdr.push_back(0);  // インターレース
+    writeChunk("IHDR", ihdr.data(), ihdr.size());
+
+    // zlibヘッダー（deflate、32KBウィンドウ）
+    idatBuffer.push_back(0x78);
+    idatBuffer.push_back(0x01);
+
+    return !failed;
+}
+
+void PngStreamWriter::writeBits(uint32_t bits, int count) {
+    bitBuffer |= bits << bitCount;
+    bitCount += count;
+    while (bitCount >= 8) {
+        idatBuffer.push_back(static_cast<sf::Uint8>(bitBuffer & 0xFF));
+        bitBuffer >>= 8;
+        bitCount -= 8;
+    }
+}
+
+void PngStreamWriter::writeHuffmanCode(uint32_t code, int length) {
+    // ハフマン符号は上位ビットから格納する
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    writeBits(reversed, length);
+}
+
+void PngStreamWriter::writeLiteral(int symbol) {
+    // 固定ハフマン符号表（RFC 1951 3.2.6）
+    if (symbol <= 143) writeHuffmanCode(0x30 + symbol, 8);
+    else if (symbol <= 255) writeHuffmanCode(0x190 + (symbol - 144), 9);
+    else if (symbol <= 279) writeHuffmanCode(symbol - 256, 7);
+    else writeHuffmanCode(0xC0 + (symbol - 280), 8);
+}
+
+void PngStreamWriter::writeMatch(int length, int distance) {
+    int code = 28;
+    while (LENGTH_BASE[code] > length) --code;
+    writeLiteral(257 + code);
+    if (LENGTH_EXTRA[code] > 0) {
+        writeBits(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+    }
+
+    // 距離1-4は拡張ビットなしの距離符号 0-3
+    writeHuffmanCode(distance - 1, 5);
+}
+
+const std::vector<sf::Uint8>& PngStreamWriter::filterRow(const sf::Uint8* row) {
+    std::vector<sf::Uint8>& none = filterCandidates[0];
+    std::vector<sf::Uint8>& sub = filterCandidates[1];
+    std::vector<sf::Uint8>& up = filterCandidates[2];
+    none[0] = 0;
+    sub[0] = 1;
+    up[0] = 2;
+
+    // 差分の絶対値の合計が最小のフィルタを選ぶ（PNG仕様の推奨ヒューリスティック）
+    long costNone = 0, costSub = 0, costUp = 0;
+    for (std::size_t i = 0; i < rowBytes; ++i) {
+        sf::Uint8 left = i >= 4 ? row[i - 4] : 0;
+        none[i + 1] = row[i];
+        sub[i + 1] = static_cast<sf::Uint8>(row[i] - left);
+        up[i + 1] = static_cast<sf::Uint8>(row[i] - previousRow[i]);
+        costNone += std::abs(static_cast<signed char>(none[i + 1]));
+        costSub += std::abs(static_cast<signed char>(sub[i + 1]));
+        costUp += std::abs(static_cast<signed char>(up[i + 1]));
+    }
+
+    std::copy(row, row + rowBytes, previousRow.begin());
+
+    if (costUp <= costSub && costUp <= costNone) return up;
+    if (costSub <= costNone) return sub;
+    return none;
+}
+
+void PngStreamWriter::compressRow(const std::vector<sf::Uint8>& data) {
+    const int size = static_cast<int>(data.size());
+    int i = 0;
+    while (i < size) {
+        // 直前のバイト（距離1）と直前のピクセル（距離4）との一致長を調べる
+        int bestLength = 0;
+        int bestDistance = 0;
+        const int limit = std::min(MAX_MATCH, size - i);
+        for (int distance : { 1, 4 }) {
+            if (i < distance) continue;
+            int length = 0;
+            while (length < limit && data[i + length] == data[i + length - distance]) {
+                ++length;
+            }
+            if (length > bestLength) {
+                bestLength = length;
+                bestDistance = distance;
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            writeMatch(bestLength, bestDistance);
+            i += bestLength;
+        }
+        else {
+            writeLiteral(data[i]);
+            ++i;
+        }
+    }
+}
+
+void PngStreamWriter::updateAdler(const sf::Uint8* data, std::size_t size) {
+    const uint32_t MOD_ADLER = 65521;
+    while (size > 0) {
+        // 32bitで溢れない範囲（5552バイト）ごとに剰余を取る
+        std::size_t block = std::min<std::size_t>(size, 5552);
+        size -= block;
+        for (std::size_t i = 0; i < block; ++i) {
+            adlerA += *data++;
+            adlerB += adlerA;
+        }
+        adlerA %= MOD_ADLER;
+        adlerB %= MOD_ADLER;
+    }
+}
+
+bool PngStreamWriter::writeRows(const sf::Uint8* pixels, unsigned rowCount) {
+    if (!file.is_open() || failed) return false;
+    if (rowsWritten + rowCount > height) {
+        std::cerr << "Error: Too many rows written to PNG stream" << std::endl;
+        failed = true;
+        return false;
+    }
+
+    // 呼び出しごとに1つの固定ハフマンブロック（BFINAL=0, BTYPE=01）
+    writeBits(0, 1);
+    writeBits(1, 2);
+
+    for (unsigned r = 0; r < rowCount; ++r) {
+        const std::vector<sf::Uint8>& filtered = filterRow(pixels + r * rowBytes);
+        updateAdler(filtered.data(), filtered.size());
+        compressRow(filtered);
+        flushIdat(false);
+    }
+
+    writeLiteral(256); // ブロック終端
+    rowsWritten += rowCount;
+    flushIdat(false);
+    return !failed;
+}
+
+bool PngStreamWriter::finish() {
+    if (!file.is_open()) return false;
+
+    if (rowsWritten != height) {
+        std::cerr << "Error: PNG stream closed with " << rowsWritten << "/" << height << " rows" << std::endl;
+        failed = true;
+    }
+
+    // 空の最終ブロック（BFINAL=1）でdeflateストリームを終端し、バイト境界に揃える
+    writeBits(1, 1);
+    writeBits(1, 2);
+    writeLiteral(256);
+    if (bitCount > 0) {
+        writeBits(0, 8 - bitCount);
+    }
+
+    appendUint32(idatBuffer, (adlerB << 16) | adlerA);
+    flushIdat(true);
+    writeChunk("IEND", nullptr, 0);
+
+    file.close();
+    return !failed && !file.fail();
+}
@@ -0,0 +1,75 @@
+﻿//===== PngStreamWriter.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * 行単位で書き込めるPNGエンコーダー（RGBA 8bit）
+ * 画像全体をメモリに持たずに、描画した行から順にファイルへ出力する
+ *
+ * 圧縮はdeflateの固定ハフマン符号による簡易実装：
+ * - 行ごとにフィルタ（None / Sub / Up）を選択
+ * - 直前のバイト・直前のピクセルとの一致（距離1と4）のみを探索
+ * ドット絵のように同色が続く画像では十分な圧縮率になる
+ */
+class PngStreamWriter {
+public:
+    /**
+     * ファイルを作成してヘッダーを書き込む
+     * @return 作成に失敗した場合false
+     */
+    bool open(const std::string& filename, unsigned width, unsigned height);
+
+    /**
+     * 上から順に行を追加
+     * @param pixels RGBAピクセル（width x rowCount）
+     * @param rowCount 行数
+     */
+    bool writeRows(const sf::Uint8* pixels, unsigned rowCount);
+
+    /**
+     * 圧縮ストリームを終端してファイルを閉じる
+     * @return 全行が書き込まれ、ファイル出力に成功した場合true
+     */
+    bool finish();
+
+private:
+    static constexpr std::size_t IDAT_CHUNK_SIZE = 64 * 1024; // IDATチャンク1つあたりの最大サイズ
+
+    std::ofstream file;
+    unsigned width = 0;
+    unsigned height = 0;
+    unsigned rowsWritten = 0;
+    std::size_t rowBytes = 0;
+    bool failed = false;
+
+    // フィルタ処理用（前の行と、フィルタ種別ごとの候補行。先頭1バイトはフィルタ種別）
+    std::vector<sf::Uint8> previousRow;
+    std::vector<sf::Uint8> filterCandidates[3];
+
+    // deflateのビット出力状態
+    uint32_t bitBuffer = 0;
+    int bitCount = 0;
+    std::vector<sf::Uint8> idatBuffer;
+
+    // zlibストリームのチェックサム
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+
+    void writeChunk(const char* type, const sf::Uint8* data, std::size_t size);
+    void flushIdat(bool force);
+
+    void writeBits(uint32_t bits, int count);
+    void writeHuffmanCode(uint32_t code, int length);
+    void writeLiteral(int symbol);
+    void writeMatch(int length, int distance);
+
+    const std::vector<sf::Uint8>& filterRow(const sf::Uint8* row);
+    void compressRow(const std::vector<sf::Uint8>& data);
+    void updateAdler(const sf::Uint8* data, std::size_t size);
+
+    static uint32_t crc32(uint32_t crc, const sf::Uint8* data, std::size_t size);
+};
@@ -6,23 +6,63 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include "AppSettings.hpp"
+#include "PaletteSnapshot.hpp"
+#include "TileGrid.hpp"
 
 // --- ^ʖ` ---
 using PatternData = std::vector<int>;
 using ColorSet = std::array<sf::Color, 3>;
-using CanvasData = std::vector<std::vector<int>>;
+using CanvasData = TileGrid;
 using GlobalColorIndices = std::array<int, 3>;
 
 // t@C`̃o[W`
 const int SAVE_FORMAT_VERSION_V1 = 1; // `iʃJ[Zbgj
 const int SAVE_FORMAT_VERSION_V2 = 2; // V`iO[oJ[VXej
 
+// --- LoXf[^̓óit@C1^Cɂint 4oCgA1oCgj ---
+
+// LoX1s܂Ƃ߂ďoĩ`N̓^Cǂ܂-1Ŗ߂j
+inline void writeCanvasTiles(std::ofstream& ofs, const CanvasData& canvas) {
+	std::vector<int> rowBuffer(canvas.getWidth());
+	for (int y = 0; y < canvas.getHeight(); ++y) {
+		canvas.readRow(y, 0, canvas.getWidth(), rowBuffer.data());
+		ofs.write(reinterpret_cast<const char*>(rowBuffer.data()), rowBuffer.size() * sizeof(int));
+	}
+}
+
+/**
+ * t@C̃LoX1sǂݍ݁AcanvasOut ƏdȂ͈͂̂ݐݒ
+ * i[łȂli-1E߁j͋^CɏC
+ * @return ǂݍ݂Ɏsꍇfalse
+ */
+inline bool readCanvasTiles(std::ifstream& ifs, size_t fileWidth, size_t fileHeight, CanvasData& canvasOut) {
+	const size_t readWidth = std::min(fileWidth, static_cast<size_t>(canvasOut.getWidth()));
+	const size_t readHeight = std::min(fileHeight, static_cast<size_t>(canvasOut.getHeight()));
+
+	std::vector<int> rowBuffer(fileWidth);
+	size_t invalidCount = 0;
+	for (size_t y = 0; y < fileHeight; ++y) {
+		ifs.read(reinterpret_cast<char*>(rowBuffer.data()), rowBuffer.size() * sizeof(int));
+		if (ifs.fail()) {
+			std::cerr << "LoXs" << y << "̓ǂݍ݃G[" << std::endl;
+			return false;
+		}
+		if (y >= readHeight) continue;
+
+		invalidCount += canvasOut.writeRow(static_cast<int>(y), 0, rowBuffer.data(), static_cast<int>(readWidth)).invalid;
+	}
+	if (invalidCount > 0) {
+		std::cerr << "sȃLoX^CCfbNX: " << invalidCount << "i^CɏCj" << std::endl;
+	}
+	return true;
+}
+
 
 
 // --- ̊֐i݊̂߈ێj ---
 
 // `ł̃Z[u֐
-void saveProject(const std::string& filename,
+inline void saveProject(const std::string& filename,
 	const std::vector<PatternData>& patterns,
 	const std::vector<ColorSet>& colorSets,
 	const CanvasData& canvas) {
@@ -60,18 +100,13 @@ void saveProject(const std::string& filename,
 	}
 
 	// LoXTCYۑ
-	size_t canvasHeight = canvas.size();
-	size_t canvasWidth = (canvasHeight > 0) ? canvas[0].size() : 0;
+	size_t canvasHeight = canvas.getHeight();
+	size_t canvasWidth = canvas.getWidth();
 	ofs.write(reinterpret_cast<const char*>(&canvasHeight), sizeof(canvasHeight));
 	ofs.write(reinterpret_cast<const char*>(&canvasWidth), sizeof(canvasWidth));
 
 	// LoXf[^ۑ
-	for (const auto& row : canvas) {
-		for (size_t x = 0; x < canvasWidth; ++x) {
-			int value = (x < row.size()) ? row[x] : -1;
-			ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
-		}
-	}
+	writeCanvasTiles(ofs, canvas);
 
 	ofs.close();
 	std::cout << "vWFNgۑ܂i`j: " << filename << std::endl;
@@ -82,7 +117,7 @@ void saveProject(const std::string& filename,
 /*
 */
 // `ł̃[h֐iCŁFo[W`FbNΉj
-bool loadProject(const std::string& filename,
+inline bool loadProject(const std::string& filename,
 	std::vector<PatternData>& patternsOut,
 	std::vector<ColorSet>& colorSetsOut,
 	CanvasData& canvasOut) {
@@ -157,7 +192,8 @@ bool loadProject(const std::string& filename,
 		ifs.read(reinterpret_cast<char*>(&canvasHeight), sizeof(canvasHeight));
 		ifs.read(reinterpret_cast<char*>(&canvasWidth), sizeof(canvasWidth));
 
-		if (ifs.fail() || canvasHeight > 1000 || canvasWidth > 1000) {
+		if (ifs.fail() || canvasHeight > static_cast<size_t>(AppSettings::MAX_CANVAS_TILES) ||
+			canvasWidth > static_cast<size_t>(AppSettings::MAX_CANVAS_TILES)) {
 			std::cerr << "sȃLoXTCY: " << canvasWidth << "x" << canvasHeight << std::endl;
 			return false;
 		}
@@ -165,22 +201,15 @@ bool loadProject(const std::string& filename,
 		std::cout << "LoXTCY: " << canvasWidth << "x" << canvasHeight << std::endl;
 
 		// LoXf[^ǂݍ
-		canvasOut.resize(canvasHeight);
-		for (size_t y = 0; y < canvasHeight; ++y) {
-			canvasOut[y].resize(canvasWidth);
-			for (size_t x = 0; x < canvasWidth; ++x) {
-				ifs.read(reinterpret_cast<char*>(&canvasOut[y][x]), sizeof(int));
-				if (ifs.fail()) {
-					std::cerr << "LoX(" << x << "," << y << ")̓ǂݍ݃G[" << std::endl;
-					return false;
-				}
-			}
+		canvasOut.resize(static_cast<int>(canvasWidth), static_cast<int>(canvasHeight));
+		if (!readCanvasTiles(ifs, canvasWidth, canvasHeight, canvasOut)) {
+			return false;
 		}
 
 		std::cout << "ǂݍ݊: "
 			<< patternsOut.size() << "p^[, "
 			<< colorSetsOut.size() << "FZbg, "
-			<< canvasOut.size() << "LoXs" << std::endl;
+			<< canvasOut.getHeight() << "LoXs" << std::endl;
 
 		return true;
 
@@ -192,7 +221,7 @@ bool loadProject(const std::string& filename,
 }
 
 // eLXg`iJSONjł̃Z[u֐ifobOpj - ̂܂
-void saveProjectText(const std::string& filename,
+inline void saveProjectText(const std::string& filename,
 	const std::vector<PatternData>& patterns,
 	const std::vector<ColorSet>& colorSets,
 	const CanvasData& canvas) {
@@ -225,8 +254,10 @@ void saveProjectText(const std::string& filename,
 		ofs << "\n";
 	}
 
-	ofs << "CANVAS=" << canvas.size() << "," << (canvas.empty() ? 0 : canvas[0].size()) << "\n";
-	for (const auto& row : canvas) {
+	ofs << "CANVAS=" << canvas.getHeight() << "," << canvas.getWidth() << "\n";
+	std::vector<int> row(canvas.getWidth());
+	for (int y = 0; y < canvas.getHeight(); ++y) {
+		canvas.readRow(y, 0, canvas.getWidth(), row.data());
 		for (size_t x = 0; x < row.size(); ++x) {
 			ofs << row[x];
 			if (x < row.size() - 1) ofs << ",";
@@ -238,10 +269,9 @@ void saveProjectText(const std::string& filename,
 	std::cout << "eLXg`ŕۑ܂: " << filename << std::endl;
 }
 // --- VO[oJ[ΉZ[u֐ ---
-void saveProjectWithGlobalColors(const std::string& filename,
-	const std::vector<PatternData>& patterns,
-	const std::vector<GlobalColorIndices>& globalColorIndices,
-	const std::array<sf::Color, 16>& globalColorPalette,
+// pbg̓XibvVbgQƂďoit@C`V2̂܂܁j
+inline void saveProjectWithGlobalColors(const std::string& filename,
+	const PaletteSnapshot& palette,
 	const CanvasData& canvas) {
 
 	std::ofstream ofs(filename, std::ios::binary);
@@ -256,53 +286,60 @@ void saveProjectWithGlobalColors(const std::string& filename,
 
 	// O[oJ[pbgi16Fjۑ
 	for (int i = 0; i < 16; ++i) {
-		sf::Uint8 r = globalColorPalette[i].r;
-		sf::Uint8 g = globalColorPalette[i].g;
-		sf::Uint8 b = globalColorPalette[i].b;
+		sf::Uint8 r = palette.globalColors[i].r;
+		sf::Uint8 g = palette.globalColors[i].g;
+		sf::Uint8 b = palette.globalColors[i].b;
 		ofs.write(reinterpret_cast<const char*>(&r), sizeof(r));
 		ofs.write(reinterpret_cast<const char*>(&g), sizeof(g));
 		ofs.write(reinterpret_cast<const char*>(&b), sizeof(b));
 	}
 
 	// p^[ۑ
-	size_t patternCount = patterns.size();
+	size_t patternCount = palette.cells.size();
 	ofs.write(reinterpret_cast<const char*>(&patternCount), sizeof(patternCount));
 
 	// ep^[ƃO[oJ[CfbNXۑ
-	for (size_t i = 0; i < patterns.size(); ++i) {
-		// p^[f[^i9vfŒj
+	for (size_t i = 0; i < palette.cells.size(); ++i) {
+		// p^[f[^i9vfŒAZȂ0j
 		for (int j = 0; j < 9; ++j) {
-			int value = (j < patterns[i].size()) ? patterns[i][j] : 0;
+			int value = palette.cells[i][j] >= 0 ? palette.cells[i][j] : 0;
 			ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
 		}
 
 		// O[oJ[CfbNXi3vfj
 		for (int c = 0; c < 3; ++c) {
-			int globalIndex = (i < globalColorIndices.size()) ? globalColorIndices[i][c] : c;
+			int globalIndex = (i < palette.colorIndices.size()) ? palette.colorIndices[i][c] : c;
 			ofs.write(reinterpret_cast<const char*>(&globalIndex), sizeof(globalIndex));
 		}
 	}
 
 	// LoXTCYۑ
-	size_t canvasHeight = canvas.size();
-	size_t canvasWidth = (canvasHeight > 0) ? canvas[0].size() : 0;
+	size_t canvasHeight = canvas.getHeight();
+	size_t canvasWidth = canvas.getWidth();
 	ofs.write(reinterpret_cast<const char*>(&canvasHeight), sizeof(canvasHeight));
 	ofs.write(reinterpret_cast<const char*>(&canvasWidth), sizeof(canvasWidth));
 
 	// LoXf[^ۑ
-	for (const auto& row : canvas) {
-		for (size_t x = 0; x < canvasWidth; ++x) {
-			int value = (x < row.size()) ? row[x] : -1;
-			ofs.write(reinterpret_cast<const char*>(&value), sizeof(value));
-		}
-	}
+	writeCanvasTiles(ofs, canvas);
 
 	ofs.close();
 	std::cout << "O[oJ[vWFNgۑ܂: " << filename << std::endl;
 }
 
+// ʂ̔z񂩂ۑi݊ێj
+inline void saveProjectWithGlobalColors(const std::string& filename,
+	const std::vector<PatternData>& patterns,
+	const std::vector<GlobalColorIndices>& globalColorIndices,
+	const std::array<sf::Color, 16>& globalColorPalette,
+	const CanvasData& canvas) {
+
+	PaletteSnapshot palette;
+	palette.assign(patterns, globalColorIndices, globalColorPalette);
+	saveProjectWithGlobalColors(filename, palette, canvas);
+}
+
 // --- VO[oJ[Ή[h֐ ---
-bool loadProjectWithGlobalColors(const std::string& filename,
+inline bool loadProjectWithGlobalColors(const std::string& filename,
 	std::vector<PatternData>& patternsOut,
 	std::vector<GlobalColorIndices>& globalColorIndicesOut,
 	std::array<sf::Color, 16>& globalColorPaletteOut,
@@ -407,7 +444,8 @@ bool loadProjectWithGlobalColors(const std::string& filename,
 		ifs.read(reinterpret_cast<char*>(&canvasHeight), sizeof(canvasHeight));
 		ifs.read(reinterpret_cast<char*>(&canvasWidth), sizeof(canvasWidth));
 
-		if (ifs.fail() || canvasHeight > 1000 || canvasWidth > 1000) {
+		if (ifs.fail() || canvasHeight > static_cast<size_t>(AppSettings::MAX_CANVAS_TILES) ||
+			canvasWidth > static_cast<size_t>(AppSettings::MAX_CANVAS_TILES)) {
 			std::cerr << "sȃLoXTCY: " << canvasWidth << "x" << canvasHeight << std::endl;
 			return false;
 		}
@@ -441,10 +479,7 @@ bool loadProjectWithGlobalColors(const std::string& filename,
 		*/
 
 		// LoXf[^ǂݍ݁iσTCYΉj
-		canvasOut.resize(AppSettings::canvasHeight); // ݂̐ݒTCYŃTCY
-		for (size_t y = 0; y < AppSettings::canvasHeight; ++y) {
-			canvasOut[y].resize(AppSettings::canvasWidth, -1); // -1ŏ
-		}
+		canvasOut.resize(AppSettings::canvasWidth, AppSettings::canvasHeight); // ݂̐ݒTCYA-1ŏ
 
 		// t@Cf[^ǂݍ݁idȂ镔̂݁j
 		size_t readHeight = std::min(canvasHeight, static_cast<size_t>(AppSettings::canvasHeight));
@@ -452,32 +487,14 @@ bool loadProjectWithGlobalColors(const std::string& filename,
 
 		std::cout << "ǂݍݔ͈: " << readWidth << "x" << readHeight << std::endl;
 
-		for (size_t y = 0; y < canvasHeight; ++y) {
-			for (size_t x = 0; x < canvasWidth; ++x) {
-				int tileValue;
-				ifs.read(reinterpret_cast<char*>(&tileValue), sizeof(int));
-				if (ifs.fail()) {
-					std::cerr << "LoX(" << x << "," << y << ")̓ǂݍ݃G[" << std::endl;
-					return false;
-				}
-
-				// ݂̃LoXTCY̏ꍇ̂ݐݒ
-				if (y < readHeight && x < readWidth) {
-					canvasOut[y][x] = tileValue;
-
-					if (canvasOut[y][x] < -1) {
-						std::cerr << "sȃLoX^CCfbNX: " << canvasOut[y][x] << std::endl;
-						canvasOut[y][x] = -1; // ^CɏC
-					}
-
-				}
-			}
+		if (!readCanvasTiles(ifs, canvasWidth, canvasHeight, canvasOut)) {
+			return false;
 		}
 
 		std::cout << "ǂݍ݊iFΉj: "
 			<< patternsOut.size() << "p^[, "
 			<< globalColorIndicesOut.size() << "O[oJ[CfbNX, "
-			<< canvasOut.size() << "LoXs" << std::endl;
+			<< canvasOut.getHeight() << "LoXs" << std::endl;
 
 		return true;
 
@@ -490,7 +507,7 @@ bool loadProjectWithGlobalColors(const std::string& filename,
 
 
 // --- [h֐iV`ʁj ---
-bool loadProjectAuto(const std::string& filename,
+inline bool loadProjectAuto(const std::string& filename,
 	std::vector<PatternData>& patternsOut,
 	std::vector<ColorSet>& colorSetsOut,
 	std::vector<GlobalColorIndices>& globalColorIndicesOut,
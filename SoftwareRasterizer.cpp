@@ -0,0 +1,208 @@
+﻿#include "SoftwareRasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <atomic>
+#include <thread>
+
+SoftwareRasterizer::SoftwareRasterizer(const PatternAtlas::Settings& tileSettings, bool showGrid,
+    const sf::Color& gridLineColor)
+    : tileSettings(tileSettings), showGrid(showGrid), gridLineColor(gridLineColor) {
+}
+
+void SoftwareRasterizer::blendPixel(sf::Uint8* dst, const sf::Uint8* src) {
+    // SFMLの BlendAlpha と同じ式（色: SrcAlpha/OneMinusSrcAlpha、アルファ: One/OneMinusSrcAlpha）
+    const int srcAlpha = src[3];
+    const int inverse = 255 - srcAlpha;
+    for (int c = 0; c < 3; ++c) {
+        dst[c] = static_cast<sf::Uint8>((src[c] * srcAlpha + dst[c] * inverse + 127) / 255);
+    }
+    dst[3] = static_cast<sf::Uint8>(srcAlpha + (dst[3] * inverse + 127) / 255);
+}
+
+void SoftwareRasterizer::prepare(const std::vector<std::array<int, 9>>& cells,
+    const std::vector<std::array<sf::Color, 3>>& colorSets) {
+
+    const std::size_t count = std::min({ cells.size(), colorSets.size(),
+        static_cast<std::size_t>(PatternAtlas::MAX_SLOTS) });
+
+    stamps.clear();
+    stamps.resize(count);
+
+    // タイル形状はアトラスと共通の処理で生成し、同じ見た目を保証する
+    sf::VertexArray geometry(sf::Quads);
+    for (std::size_t p = 0; p < count; ++p) {
+        geometry.clear();
+        PatternAtlas::appendTileGeometry(geometry, 0.0f, 0.0f, cells[p], colorSets[p], tileSettings);
+        buildStamp(stamps[p], geometry);
+    }
+}
+
+void SoftwareRasterizer::buildStamp(Stamp& stamp, const sf::VertexArray& geometry) const {
+    const int tileSize = tileSettings.tileSize;
+    stamp.used = true;
+    stamp.pixels.assign(static_cast<std::size_t>(tileSize) * tileSize * 4, 0);
+
+    // 各Quadを軸平行矩形として塗る（頂点0が左上、頂点2が右下）
+    for (std::size_t v = 0; v + 3 < geometry.getVertexCount(); v += 4) {
+        const sf::Vector2f& topLeft = geometry[v].position;
+        const sf::Vector2f& bottomRight = geometry[v + 2].position;
+        const sf::Color& color = geometry[v].color;
+
+        // ピクセル中心が [x0, x1) に入る範囲
+        int firstX = std::max(0, static_cast<int>(std::ceil(topLeft.x - 0.5f)));
+        int lastX = std::min(tileSize - 1, static_cast<int>(std::ceil(bottomRight.x - 0.5f)) - 1);
+        int firstY = std::max(0, static_cast<int>(std::ceil(topLeft.y - 0.5f)));
+        int lastY = std::min(tileSize - 1, static_cast<int>(std::ceil(bottomRight.y - 0.5f)) - 1);
+
+        const sf::Uint8 src[4] = { color.r, color.g, color.b, color.a };
+        for (int y = firstY; y <= lastY; ++y) {
+            sf::Uint8* row = &stamp.pixels[(static_cast<std::size_t>(y) * tileSize) * 4];
+            for (int x = firstX; x <= lastX; ++x) {
+                blendPixel(row + x * 4, src);
+            }
+        }
+    }
+
+    // 行ごとに透明でないピクセルの連続範囲をまとめる
+    stamp.runs.clear();
+    stamp.rowRunOffsets.assign(tileSize + 1, 0);
+    for (int y = 0; y < tileSize; ++y) {
+        stamp.rowRunOffsets[y] = static_cast<int>(stamp.runs.size());
+        const sf::Uint8* row = &stamp.pixels[(static_cast<std::size_t>(y) * tileSize) * 4];
+
+        int x = 0;
+        while (x < tileSize) {
+            sf::Uint8 alpha = row[x * 4 + 3];
+            if (alpha == 0) {
+                ++x;
+                continue;
+            }
+            bool opaque = (alpha == 255);
+            int begin = x;
+            while (x < tileSize && row[x * 4 + 3] != 0 && (row[x * 4 + 3] == 255) == opaque) {
+                ++x;
+            }
+            stamp.runs.push_back({ begin, x, opaque });
+        }
+    }
+    stamp.rowRunOffsets[tileSize] = static_cast<int>(stamp.runs.size());
+}
+
+void SoftwareRasterizer::renderTileRows(const TileGrid& tiles,
+    int tileRowBegin, int tileRowEnd, sf::Uint8* pixels) const {
+
+    if (tiles.empty() || tileRowBegin >= tileRowEnd) return;
+
+    const int tileSize = tileSettings.tileSize;
+    const int columns = tiles.getWidth();
+    const std::size_t rowBytes = static_cast<std::size_t>(columns) * tileSize * 4;
+    const std::size_t bandRows = static_cast<std::size_t>(tileRowEnd - tileRowBegin) * tileSize;
+
+    // 背景は透明
+    std::memset(pixels, 0, rowBytes * bandRows);
+
+    // グリッド線（タイルの下に描画）
+    if (showGrid) {
+        const sf::Uint8 line[4] = { gridLineColor.r, gridLineColor.g, gridLineColor.b, gridLineColor.a };
+        for (std::size_t y = 0; y < bandRows; ++y) {
+            sf::Uint8* row = pixels + y * rowBytes;
+            if (y % tileSize == 0) {
+                // 横線：タイル行の上端
+                for (int x = 0; x < columns * tileSize; ++x) {
+                    blendPixel(row + x * 4, line);
+                }
+            }
+            else {
+                // 縦線：タイル列の左端
+                for (int tx = 0; tx < columns; ++tx) {
+                    blendPixel(row + static_cast<std::size_t>(tx) * tileSize * 4, line);
+                }
+            }
+        }
+    }
+
+    const int stampCount = static_cast<int>(stamps.size());
+    for (int ty = tileRowBegin; ty < tileRowEnd; ++ty) {
+        sf::Uint8* bandTop = pixels + static_cast<std::size_t>(ty - tileRowBegin) * tileSize * rowBytes;
+
+        // 空のチャンクの区間は訪問されない
+        tiles.forEachRowSegment(ty, [&](int segmentX, const TileGrid::Cell* segment, int count) {
+            for (int i = 0; i < count; ++i) {
+                const int tx = segmentX + i;
+                int tileIndex = segment[i];
+                if (tileIndex < 0 || tileIndex >= stampCount) continue;
+
+                const Stamp& stamp = stamps[tileIndex];
+                if (!stamp.used) continue;
+
+                for (int y = 0; y < tileSize; ++y) {
+                    sf::Uint8* dstRow = bandTop + y * rowBytes + static_cast<std::size_t>(tx) * tileSize * 4;
+                    const sf::Uint8* srcRow = &stamp.pixels[(static_cast<std::size_t>(y) * tileSize) * 4];
+
+                    for (int r = stamp.rowRunOffsets[y]; r < stamp.rowRunOffsets[y + 1]; ++r) {
+                        const Run& run = stamp.runs[r];
+                        if (run.opaque) {
+                            std::memcpy(dstRow + run.begin * 4, srcRow + run.begin * 4, (run.end - run.begin) * 4);
+                        }
+                        else {
+                            for (int x = run.begin; x < run.end; ++x) {
+                                blendPixel(dstRow + x * 4, srcRow + x * 4);
+                            }
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
+
+unsigned SoftwareRasterizer::getDefaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+void SoftwareRasterizer::renderTileRowsParallel(const TileGrid& tiles,
+    int tileRowBegin, int tileRowEnd, sf::Uint8* pixels, unsigned threadCount) const {
+
+    if (tiles.empty() || tileRowBegin >= tileRowEnd) return;
+
+    if (threadCount == 0) {
+        threadCount = getDefaultThreadCount();
+    }
+
+    // 範囲が狭い場合（ストリーミング出力の1バンド等）もスレッド数分に分割できるようバンドを細かくする
+    const int totalRows = tileRowEnd - tileRowBegin;
+    const int bandRows = std::max(1, std::min(BAND_TILE_ROWS, totalRows / static_cast<int>(threadCount)));
+    const int bandCount = (totalRows + bandRows - 1) / bandRows;
+    threadCount = std::min(threadCount, static_cast<unsigned>(bandCount));
+
+    if (threadCount <= 1) {
+        renderTileRows(tiles, tileRowBegin, tileRowEnd, pixels);
+        return;
+    }
+
+    const std::size_t bandBytes = static_cast<std::size_t>(tiles.getWidth()) * tileSettings.tileSize * 4 *
+        tileSettings.tileSize * bandRows;
+
+    // 各ワーカーは未処理のバンドを順に取り出して描画（バンド同士は出力領域が重ならない）
+    std::atomic<int> nextBand(0);
+    auto worker = [&]() {
+        for (int band = nextBand++; band < bandCount; band = nextBand++) {
+            int rowBegin = tileRowBegin + band * bandRows;
+            int rowEnd = std::min(tileRowEnd, rowBegin + bandRows);
+            renderTileRows(tiles, rowBegin, rowEnd, pixels + bandBytes * band);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (unsigned i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker(); // 呼び出しスレッドも処理に参加
+
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
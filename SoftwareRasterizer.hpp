@@ -0,0 +1,86 @@
+﻿//===== SoftwareRasterizer.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <array>
+#include "PatternAtlas.hpp"
+#include "TileGrid.hpp"
+
+/**
+ * CPUのみで動作するキャンバス描画（画像出力用）
+ * タイル・パターン・色からRGBAのピクセルバッファへ直接書き込むため、
+ * ウィンドウやGLコンテキスト、GPUからの読み戻しを必要としない
+ *
+ * 描画結果はGPU描画と同じ規則に従う：
+ * - 矩形はピクセル中心が [x0, x1) x [y0, y1) に入るピクセルを塗る
+ * - 色の合成はSFMLの BlendAlpha と同じ式
+ */
+class SoftwareRasterizer {
+public:
+    /**
+     * @param tileSettings タイルサイズ・spacing・shrink・タイル内部グリッド色
+     * @param showGrid キャンバスのグリッド線を描画するか
+     * @param gridLineColor グリッド線の色
+     */
+    SoftwareRasterizer(const PatternAtlas::Settings& tileSettings, bool showGrid, const sf::Color& gridLineColor);
+
+    /**
+     * パターンごとに1タイル分のスタンプを事前生成
+     * @param cells パターンごとの3x3セル（PaletteSnapshot::cells）
+     * @param colorSets パターンごとの3色
+     */
+    void prepare(const std::vector<std::array<int, 9>>& cells,
+        const std::vector<std::array<sf::Color, 3>>& colorSets);
+
+    /**
+     * タイル行の範囲をRGBAバッファへ描画
+     * 各行は独立しているため、異なる範囲を別スレッドから同時に呼び出してよい
+     * @param tiles タイル配列
+     * @param tileRowBegin 描画開始タイル行
+     * @param tileRowEnd 描画終了タイル行（この行は含まない）
+     * @param pixels 出力先（tileRowBegin 行目の上端から始まるRGBAバッファ）
+     */
+    void renderTileRows(const TileGrid& tiles,
+        int tileRowBegin, int tileRowEnd, sf::Uint8* pixels) const;
+
+    /**
+     * タイル行の範囲を帯（バンド）に分割し、複数スレッドで描画
+     * 各バンドは renderTileRows と同じ処理のため、結果は1スレッドの場合とビット単位で一致する
+     * @param threadCount 使用スレッド数（0 = ハードウェアの同時実行数）
+     */
+    void renderTileRowsParallel(const TileGrid& tiles,
+        int tileRowBegin, int tileRowEnd, sf::Uint8* pixels, unsigned threadCount = 0) const;
+
+    // 既定のスレッド数（ハードウェアの同時実行数、取得できない場合は1）
+    static unsigned getDefaultThreadCount();
+
+    int getTileSize() const { return tileSettings.tileSize; }
+
+private:
+    // 不透明度の等しい連続ピクセル（スタンプ1行内）
+    struct Run {
+        int begin;
+        int end;
+        bool opaque; // true: そのままコピー、false: アルファ合成
+    };
+
+    // 1パターン分のタイル画像と、行ごとの描画対象ピクセル範囲
+    struct Stamp {
+        bool used = false;
+        std::vector<sf::Uint8> pixels;  // tileSize x tileSize x RGBA
+        std::vector<Run> runs;
+        std::vector<int> rowRunOffsets; // 行 r の Run は [rowRunOffsets[r], rowRunOffsets[r + 1])
+    };
+
+    // 1バンドあたりのタイル行数（スレッド間の負荷の偏りを抑えるため細かめに分割）
+    static constexpr int BAND_TILE_ROWS = 4;
+
+    PatternAtlas::Settings tileSettings;
+    bool showGrid;
+    sf::Color gridLineColor;
+    std::vector<Stamp> stamps;
+
+    void buildStamp(Stamp& stamp, const sf::VertexArray& geometry) const;
+
+    static void blendPixel(sf::Uint8* dst, const sf::Uint8* src);
+};
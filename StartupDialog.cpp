@@ -1,6 +1,7 @@
 // ===== StartupDialog.cpp =====
 
 #include "StartupDialog.hpp"
+#include "AppSettings.hpp"
 #include <iostream>
 #include <algorithm>
 
@@ -149,13 +150,13 @@ void StartupDialog::validateAndUpdateSettings() {
         settings.tileSize = std::stoi(tileSizeInput);
     }
 
-    // LoX̌؁i50-500͈̔́j
-    if (isValidInput(widthInput, 50, 500)) {
+    // LoX̌؁i50-4096͈̔́j
+    if (isValidInput(widthInput, AppSettings::MIN_CANVAS_TILES, AppSettings::MAX_CANVAS_TILES)) {
         settings.canvasWidth = std::stoi(widthInput);
     }
 
-    // LoX̌؁i50-500͈̔́j
-    if (isValidInput(heightInput, 50, 500)) {
+    // LoX̌؁i50-4096͈̔́j
+    if (isValidInput(heightInput, AppSettings::MIN_CANVAS_TILES, AppSettings::MAX_CANVAS_TILES)) {
         settings.canvasHeight = std::stoi(heightInput);
     }
 
@@ -183,8 +184,8 @@ void StartupDialog::draw() {
 
     // x
     drawText("Tile Size (3-30):", 720, 385, 14, sf::Color::White);
-    drawText("Width (50-500):", 720, 425, 14, sf::Color::White);
-    drawText("Height (50-500):", 720, 465, 14, sf::Color::White);
+    drawText("Width (50-4096):", 720, 425, 14, sf::Color::White);
+    drawText("Height (50-4096):", 720, 465, 14, sf::Color::White);
 
     // ̓tB[h
     drawInputField(window, tileSizeField, tileSizeInput, activeField == ActiveField::TILE_SIZE);
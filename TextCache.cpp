@@ -0,0 +1,93 @@
+﻿#include "TextCache.hpp"
+#include <functional>
+
+TextCache::TextCache(std::size_t capacity)
+    : capacity(capacity > 0 ? capacity : 1) {
+}
+
+TextCache& TextCache::shared() {
+    static TextCache cache;
+    return cache;
+}
+
+std::size_t TextCache::makeHash(const sf::Font& font, std::string_view text, unsigned int size) {
+    std::size_t hash = std::hash<std::string_view>()(text);
+    hash ^= std::hash<const void*>()(&font) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<unsigned int>()(size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+TextCache::Entry& TextCache::lookup(const sf::Font& font, std::string_view text, unsigned int size) {
+    const std::size_t hash = makeHash(font, text, size);
+
+    // 登録済みなら先頭へ移動して返す（文字列の比較のみでメモリ確保なし）
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        Entry& entry = *it->second;
+        if (entry.font == &font && entry.characterSize == size && entry.text == text) {
+            entries.splice(entries.begin(), entries, it->second);
+            return entry;
+        }
+    }
+
+    // 上限に達していれば最も古いものを破棄
+    if (entries.size() >= capacity) {
+        auto oldest = std::prev(entries.end());
+        auto oldRange = index.equal_range(oldest->hash);
+        for (auto it = oldRange.first; it != oldRange.second; ++it) {
+            if (it->second == oldest) {
+                index.erase(it);
+                break;
+            }
+        }
+        entries.erase(oldest);
+    }
+
+    entries.emplace_front();
+    Entry& entry = entries.front();
+    entry.text.assign(text.data(), text.size());
+    entry.characterSize = size;
+    entry.font = &font;
+    entry.hash = hash;
+    entry.drawable.setFont(font);
+    entry.drawable.setString(entry.text);
+    entry.drawable.setCharacterSize(size);
+
+    // 最後の文字の次の位置が送り幅（原点に置いた状態で計算）
+    entry.advance = entry.drawable.findCharacterPos(entry.drawable.getString().getSize()).x;
+
+    index.emplace(hash, entries.begin());
+    return entry;
+}
+
+sf::Text& TextCache::get(const sf::Font& font, std::string_view text, unsigned int size) {
+    return lookup(font, text, size).drawable;
+}
+
+float TextCache::draw(sf::RenderTarget& target, const sf::Font& font, std::string_view text,
+    unsigned int size, const sf::Vector2f& position, const sf::Color& color) {
+
+    Entry& entry = lookup(font, text, size);
+    entry.drawable.setPosition(position);
+    if (entry.drawable.getFillColor() != color) {
+        entry.drawable.setFillColor(color);
+    }
+    target.draw(entry.drawable);
+    return entry.advance;
+}
+
+void TextCache::drawFragments(sf::RenderTarget& target, const sf::Font& font, unsigned int size,
+    const sf::Vector2f& position, const sf::Color& color,
+    std::initializer_list<std::string_view> fragments) {
+
+    sf::Vector2f pen = position;
+    for (std::string_view fragment : fragments) {
+        if (fragment.empty()) continue;
+        pen.x += draw(target, font, fragment, size, pen, color);
+    }
+}
+
+void TextCache::clear() {
+    index.clear();
+    entries.clear();
+}
@@ -0,0 +1,68 @@
+﻿//===== TextCache.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <string_view>
+#include <list>
+#include <unordered_map>
+#include <initializer_list>
+#include <cstddef>
+
+/**
+ * レイアウト済みテキストのキャッシュ
+ * 文字列・文字サイズ・フォントの組ごとにsf::Textを保持し、同じ文字列を再び描画する場合は
+ * グリフの配置（頂点の生成）をやり直さない。位置と色は描画時に設定するだけで済む
+ * 上限を超えた場合は最も長く使われていないものから破棄する（LRU）
+ */
+class TextCache {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 256;
+
+    explicit TextCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    // UI全体で共有するキャッシュ
+    static TextCache& shared();
+
+    /**
+     * レイアウト済みのテキストを取得（未登録の場合のみ生成）
+     * 返す参照は次に get/draw を呼ぶまで有効
+     */
+    sf::Text& get(const sf::Font& font, std::string_view text, unsigned int size);
+
+    /**
+     * テキストを描画
+     * @return テキストの送り幅（末尾の空白を含む。続く断片の描画位置に使用）
+     */
+    float draw(sf::RenderTarget& target, const sf::Font& font, std::string_view text,
+        unsigned int size, const sf::Vector2f& position, const sf::Color& color);
+
+    /**
+     * 複数の断片を続けて1行として描画
+     * 固定の見出しと変化する数値を別々にキャッシュするため、数値が変わっても見出しは作り直さない
+     */
+    void drawFragments(sf::RenderTarget& target, const sf::Font& font, unsigned int size,
+        const sf::Vector2f& position, const sf::Color& color,
+        std::initializer_list<std::string_view> fragments);
+
+    void clear();
+
+    std::size_t getSize() const { return entries.size(); }
+
+private:
+    struct Entry {
+        std::string text;
+        unsigned int characterSize = 0;
+        const sf::Font* font = nullptr;
+        std::size_t hash = 0;
+        sf::Text drawable;
+        float advance = 0.0f;
+    };
+
+    std::size_t capacity;
+    std::list<Entry> entries; // 先頭ほど最近使用したもの
+    std::unordered_multimap<std::size_t, std::list<Entry>::iterator> index;
+
+    static std::size_t makeHash(const sf::Font& font, std::string_view text, unsigned int size);
+
+    Entry& lookup(const sf::Font& font, std::string_view text, unsigned int size);
+};
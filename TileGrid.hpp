@@ -0,0 +1,483 @@
+﻿//===== TileGrid.hpp =====
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+
+/**
+ * キャンバスのタイル配列（1タイル1バイト、-1 = 空）
+ * パターン番号は最大64のため int8_t で足りる
+ *
+ * 格納方式は2種類：
+ * - Dense  : 1本の連続したバッファに行優先で格納
+ * - Sparse : CHUNK_SIZE 四方のチャンク単位で格納し、最初の書き込みで確保・全て空に戻ったら解放
+ *            メモリは描かれた面積に比例する
+ * どちらの方式でもチャンクごとの配置数と占有ビットを保持するため、
+ * forEachRowSegment による走査・countFilled は空のチャンクを読まずに飛ばす
+ *
+ * 格納領域は共有ポインタで保持し、コピーはO(1)のスナップショットになる（コピーオンライト）
+ * 共有中の領域へ書き込む側だけが複製を作る：疎格納は書き込んだチャンクのみ、密格納はバッファ全体
+ * スナップショットは他の TileGrid への書き込みの影響を受けない
+ */
+class TileGrid {
+public:
+    using Cell = int8_t;
+    static constexpr int EMPTY = -1;
+    static constexpr int MAX_VALUE = INT8_MAX; // 格納できる最大のタイル番号
+    static constexpr int CHUNK_SIZE = 64;      // 占有管理・疎格納のチャンク1辺のタイル数
+    static constexpr int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+    enum class Storage {
+        Dense,
+        Sparse
+    };
+
+    /**
+     * 行単位の書き込み結果
+     */
+    struct RowWrite {
+        int changed = 0;     // 値が変化したタイル数
+        int filledDelta = 0; // 配置済み（空でない）タイル数の増減
+        int invalid = 0;     // 格納できずに空として書き込んだ値の数（writeRow のみ）
+    };
+
+    TileGrid() = default;
+
+    TileGrid(int width, int height, int fillValue = EMPTY, Storage storage = Storage::Dense)
+        : storage(storage) {
+        resize(width, height, fillValue);
+    }
+
+    // コピーは格納領域を共有するだけ（O(1)）
+    TileGrid(const TileGrid& other) = default;
+    TileGrid& operator=(const TileGrid& other) = default;
+
+    TileGrid(TileGrid&& other) noexcept { *this = std::move(other); }
+
+    TileGrid& operator=(TileGrid&& other) noexcept {
+        if (this != &other) {
+            width = other.width;
+            height = other.height;
+            chunksX = other.chunksX;
+            chunksY = other.chunksY;
+            storage = other.storage;
+            cells = std::move(other.cells);
+            chunks = std::move(other.chunks);
+            occupancy = std::move(other.occupancy);
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * サイズを変更し、全タイルを fillValue で初期化（格納方式は維持）
+     * スナップショットと共有していた領域は手放し、新しく確保する
+     */
+    void resize(int newWidth, int newHeight, int fillValue = EMPTY) {
+        width = std::max(0, newWidth);
+        height = std::max(0, newHeight);
+        chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const std::size_t chunkCount = static_cast<std::size_t>(chunksX) * chunksY;
+
+        occupancy = std::make_shared<Occupancy>();
+        occupancy->filled.assign(chunkCount, 0);
+        occupancy->bits.assign((chunkCount + 63) / 64, 0);
+        cells.reset();
+        chunks.reset();
+        if (storage == Storage::Dense) {
+            cells = std::make_shared<CellBuffer>(static_cast<std::size_t>(width) * height, static_cast<Cell>(EMPTY));
+        }
+        else {
+            chunks = std::make_shared<ChunkTable>(chunkCount);
+        }
+        if (toCell(fillValue) != EMPTY) {
+            fill(fillValue);
+        }
+    }
+
+    void clear() {
+        width = height = chunksX = chunksY = 0;
+        cells.reset();
+        chunks.reset();
+        occupancy.reset();
+    }
+
+    /**
+     * 格納方式を切り替える（内容は保持）
+     */
+    void setStorage(Storage newStorage) {
+        if (newStorage == storage) return;
+        TileGrid converted(width, height, EMPTY, newStorage);
+        for (int y = 0; y < height; ++y) {
+            forEachRowSegment(y, [&](int x, const Cell* segment, int count) {
+                converted.writeRow(y, x, segment, count);
+            });
+        }
+        *this = std::move(converted);
+    }
+
+    Storage getStorage() const { return storage; }
+    bool isSparse() const { return storage == Storage::Sparse; }
+
+    bool empty() const { return width == 0 || height == 0; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    bool contains(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    int get(int x, int y) const {
+        if (storage == Storage::Dense) return (*cells)[denseIndex(x, y)];
+        const Chunk* chunk = (*chunks)[chunkIndex(x, y)].get();
+        return chunk ? chunk->cells[localIndex(x, y)] : EMPTY;
+    }
+
+    /**
+     * タイルを書き込む（格納できない値は空として扱う）
+     * @return 値が変化した場合true
+     */
+    bool set(int x, int y, int value) {
+        const Cell newValue = toCell(value);
+        const int current = get(x, y);
+        if (current == newValue) return false; // 変化がなければ共有領域も複製しない
+
+        const std::size_t chunk = chunkIndex(x, y);
+        Cell* cell = cellPointer(x, y, chunk);
+        *cell = newValue;
+        if ((current >= 0) != (newValue >= 0)) {
+            adjustFilled(chunk, current >= 0 ? -1 : 1);
+        }
+        return true;
+    }
+
+    // ===== 格納方式によらない走査 =====
+
+    /**
+     * 1行の [x0, x1) のうち、空でないチャンクに含まれる区間を順に訪問
+     * 区間はチャンク境界で分割され、空のチャンクの区間は呼び出されない（区間内には空タイルも含まれる）
+     * @param visitor void(int x, const Cell* cells, int count)
+     */
+    template <typename Visitor>
+    void forEachRowSegment(int y, int x0, int x1, Visitor&& visitor) const {
+        if (y < 0 || y >= height) return;
+        x0 = std::max(0, x0);
+        x1 = std::min(width, x1);
+        const int cy = y / CHUNK_SIZE;
+
+        for (int x = x0; x < x1;) {
+            const int cx = x / CHUNK_SIZE;
+            const int segmentEnd = std::min(x1, (cx + 1) * CHUNK_SIZE);
+            const std::size_t chunk = static_cast<std::size_t>(cy) * chunksX + cx;
+            if (occupancy->filled[chunk] > 0) {
+                visitor(x, cellData(x, y, chunk), segmentEnd - x);
+            }
+            x = segmentEnd;
+        }
+    }
+
+    template <typename Visitor>
+    void forEachRowSegment(int y, Visitor&& visitor) const {
+        forEachRowSegment(y, 0, width, std::forward<Visitor>(visitor));
+    }
+
+    /**
+     * 1行の [x0, x1) を out へ展開（空のチャンクは EMPTY で埋める）
+     */
+    template <typename T>
+    void readRow(int y, int x0, int x1, T* out) const {
+        std::fill(out, out + std::max(0, x1 - x0), static_cast<T>(EMPTY));
+        forEachRowSegment(y, x0, x1, [&](int x, const Cell* segment, int count) {
+            std::copy(segment, segment + count, out + (x - x0));
+        });
+    }
+
+    void fill(int value) {
+        for (int y = 0; y < height; ++y) {
+            fillRowSpan(y, 0, width, value);
+        }
+    }
+
+    /**
+     * 1行の [x0, x1) を同じ値で埋める（範囲外は切り詰める）
+     * 既に同じ値のチャンク区間は書き込まない（共有領域も複製しない）
+     * @return 変化したタイル数と配置数の増減
+     */
+    RowWrite fillRowSpan(int y, int x0, int x1, int value) {
+        RowWrite result;
+        if (y < 0 || y >= height) return result;
+        x0 = std::max(0, x0);
+        x1 = std::min(width, x1);
+        if (x1 <= x0) return result;
+
+        const Cell newValue = toCell(value);
+        const int cy = y / CHUNK_SIZE;
+        for (int x = x0; x < x1;) {
+            const int cx = x / CHUNK_SIZE;
+            const int segmentEnd = std::min(x1, (cx + 1) * CHUNK_SIZE);
+            const int length = segmentEnd - x;
+            const std::size_t chunk = static_cast<std::size_t>(cy) * chunksX + cx;
+            if (occupancy->filled[chunk] == 0) {
+                if (newValue != EMPTY) {
+                    Cell* segment = cellPointer(x, y, chunk);
+                    std::fill(segment, segment + length, newValue);
+                    adjustFilled(chunk, length);
+                    result.changed += length;
+                    result.filledDelta += length;
+                }
+                x = segmentEnd;
+                continue;
+            }
+
+            const Cell* current = cellData(x, y, chunk);
+            int segmentChanged = 0;
+            int delta = 0;
+            for (int i = 0; i < length; ++i) {
+                segmentChanged += current[i] != newValue;
+                delta += (newValue >= 0) - (current[i] >= 0);
+            }
+            if (segmentChanged > 0) {
+                Cell* segment = cellPointer(x, y, chunk);
+                std::fill(segment, segment + length, newValue);
+                if (delta != 0) adjustFilled(chunk, delta);
+                result.changed += segmentChanged;
+                result.filledDelta += delta;
+            }
+            x = segmentEnd;
+        }
+        return result;
+    }
+
+    /**
+     * 1行の [x0, x0 + count) へ values を順に書き込む（範囲外は切り詰める）
+     * 値が変わらないチャンク区間は書き込まない（空のチャンクの確保も共有領域の複製もしない）
+     * @return 変化したタイル数・配置数の増減・格納できずに空とした値の数
+     */
+    template <typename T>
+    RowWrite writeRow(int y, int x0, const T* values, int count) {
+        RowWrite result;
+        if (y < 0 || y >= height) return result;
+        int x1 = std::min(width, x0 + count);
+        if (x0 < 0) {
+            values -= x0;
+            x0 = 0;
+        }
+        if (x1 <= x0) return result;
+
+        const int cy = y / CHUNK_SIZE;
+        for (int x = x0; x < x1;) {
+            const int cx = x / CHUNK_SIZE;
+            const int segmentEnd = std::min(x1, (cx + 1) * CHUNK_SIZE);
+            const int length = segmentEnd - x;
+            const T* source = values + (x - x0);
+            const std::size_t chunk = static_cast<std::size_t>(cy) * chunksX + cx;
+
+            // 空のチャンクは未確保の場合があるため、現在値を読まずに空として比較する
+            const Cell* current = occupancy->filled[chunk] > 0 ? cellData(x, y, chunk) : nullptr;
+            int segmentChanged = 0;
+            int delta = 0;
+            for (int i = 0; i < length; ++i) {
+                const Cell value = toCell(source[i]);
+                if (value != source[i] && source[i] != EMPTY) ++result.invalid;
+                const Cell before = current ? current[i] : static_cast<Cell>(EMPTY);
+                segmentChanged += value != before;
+                delta += (value >= 0) - (before >= 0);
+            }
+            if (segmentChanged > 0) {
+                Cell* segment = cellPointer(x, y, chunk);
+                for (int i = 0; i < length; ++i) {
+                    segment[i] = toCell(source[i]);
+                }
+                if (delta != 0) adjustFilled(chunk, delta);
+                result.changed += segmentChanged;
+                result.filledDelta += delta;
+            }
+            x = segmentEnd;
+        }
+        return result;
+    }
+
+    // 矩形範囲内の配置済み（空でない）タイル数（全体を含むチャンクは集計値を使用）
+    int countFilled(const sf::IntRect& rect) const {
+        const int left = std::max(0, rect.left);
+        const int top = std::max(0, rect.top);
+        const int right = std::min(width, rect.left + rect.width);
+        const int bottom = std::min(height, rect.top + rect.height);
+        if (right <= left || bottom <= top) return 0;
+
+        int count = 0;
+        for (int cy = top / CHUNK_SIZE; cy <= (bottom - 1) / CHUNK_SIZE; ++cy) {
+            for (int cx = left / CHUNK_SIZE; cx <= (right - 1) / CHUNK_SIZE; ++cx) {
+                const std::size_t chunk = static_cast<std::size_t>(cy) * chunksX + cx;
+                if (occupancy->filled[chunk] == 0) continue;
+
+                const int chunkLeft = cx * CHUNK_SIZE, chunkTop = cy * CHUNK_SIZE;
+                const int x0 = std::max(left, chunkLeft), x1 = std::min(right, chunkLeft + CHUNK_SIZE);
+                const int y0 = std::max(top, chunkTop), y1 = std::min(bottom, chunkTop + CHUNK_SIZE);
+                if (x0 == chunkLeft && y0 == chunkTop &&
+                    x1 == std::min(width, chunkLeft + CHUNK_SIZE) && y1 == std::min(height, chunkTop + CHUNK_SIZE)) {
+                    count += occupancy->filled[chunk];
+                    continue;
+                }
+                for (int y = y0; y < y1; ++y) {
+                    forEachRowSegment(y, x0, x1, [&](int, const Cell* segment, int length) {
+                        for (int i = 0; i < length; ++i) {
+                            if (segment[i] >= 0) ++count;
+                        }
+                    });
+                }
+            }
+        }
+        return count;
+    }
+
+    int getFilledCount() const {
+        int count = 0;
+        if (occupancy) {
+            for (uint16_t filled : occupancy->filled) count += filled;
+        }
+        return count;
+    }
+
+    // ===== チャンク単位の占有情報 =====
+
+    int getChunksX() const { return chunksX; }
+    int getChunksY() const { return chunksY; }
+
+    bool isChunkOccupied(int cx, int cy) const {
+        const std::size_t chunk = static_cast<std::size_t>(cy) * chunksX + cx;
+        return (occupancy->bits[chunk / 64] >> (chunk % 64)) & 1;
+    }
+
+    // 矩形範囲に重なるチャンクが全て空ならtrue（チャンク単位の判定のため走査は発生しない）
+    bool isRegionEmpty(const sf::IntRect& rect) const {
+        const int left = std::max(0, rect.left);
+        const int top = std::max(0, rect.top);
+        const int right = std::min(width, rect.left + rect.width);
+        const int bottom = std::min(height, rect.top + rect.height);
+        if (right <= left || bottom <= top) return true;
+
+        for (int cy = top / CHUNK_SIZE; cy <= (bottom - 1) / CHUNK_SIZE; ++cy) {
+            for (int cx = left / CHUNK_SIZE; cx <= (right - 1) / CHUNK_SIZE; ++cx) {
+                if (isChunkOccupied(cx, cy)) return false;
+            }
+        }
+        return true;
+    }
+
+    // 使用メモリ（バイト、スナップショットと共有中の領域も含む）
+    std::size_t getMemoryUsage() const {
+        std::size_t bytes = 0;
+        if (cells) bytes += cells->capacity() * sizeof(Cell);
+        if (chunks) {
+            bytes += chunks->capacity() * sizeof(std::shared_ptr<Chunk>);
+            for (const auto& chunk : *chunks) {
+                if (chunk) bytes += sizeof(Chunk);
+            }
+        }
+        if (occupancy) {
+            bytes += occupancy->filled.capacity() * sizeof(uint16_t) + occupancy->bits.capacity() * sizeof(uint64_t);
+        }
+        return bytes;
+    }
+
+    bool operator==(const TileGrid& other) const {
+        if (width != other.width || height != other.height) return false;
+        if (empty()) return true;
+        if (occupancy->filled != other.occupancy->filled) return false;
+        std::vector<Cell> rowA(width), rowB(width);
+        for (int y = 0; y < height; ++y) {
+            readRow(y, 0, width, rowA.data());
+            other.readRow(y, 0, width, rowB.data());
+            if (rowA != rowB) return false;
+        }
+        return true;
+    }
+    bool operator!=(const TileGrid& other) const { return !(*this == other); }
+
+    // 格納できる値に変換（-1 未満・上限超過は空）
+    static Cell toCell(int value) {
+        return (value >= 0 && value <= MAX_VALUE) ? static_cast<Cell>(value) : static_cast<Cell>(EMPTY);
+    }
+
+private:
+    struct Chunk {
+        std::array<Cell, CHUNK_CELLS> cells;
+    };
+
+    using CellBuffer = std::vector<Cell>;
+    using ChunkTable = std::vector<std::shared_ptr<Chunk>>;
+
+    // チャンクごとの配置済みタイル数と占有ビット
+    struct Occupancy {
+        std::vector<uint16_t> filled;
+        std::vector<uint64_t> bits;
+    };
+
+    std::size_t denseIndex(int x, int y) const {
+        return static_cast<std::size_t>(y) * width + x;
+    }
+    std::size_t chunkIndex(int x, int y) const {
+        return static_cast<std::size_t>(y / CHUNK_SIZE) * chunksX + x / CHUNK_SIZE;
+    }
+    static int localIndex(int x, int y) {
+        return (y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE;
+    }
+
+    // 共有中なら複製して、このインスタンス専用にする
+    template <typename T>
+    static T& makeUnique(std::shared_ptr<T>& shared) {
+        if (shared.use_count() > 1) shared = std::make_shared<T>(*shared);
+        return *shared;
+    }
+
+    // 読み取り用のタイルへのポインタ（疎格納では確保済みのチャンクのみ）
+    const Cell* cellData(int x, int y, std::size_t chunk) const {
+        if (storage == Storage::Dense) return cells->data() + denseIndex(x, y);
+        return (*chunks)[chunk]->cells.data() + localIndex(x, y);
+    }
+
+    /**
+     * 書き込み先のタイルへのポインタ
+     * 共有中の領域は先に複製し、疎格納で未確保のチャンクはここで確保する
+     */
+    Cell* cellPointer(int x, int y, std::size_t chunk) {
+        if (storage == Storage::Dense) return makeUnique(cells).data() + denseIndex(x, y);
+
+        std::shared_ptr<Chunk>& entry = makeUnique(chunks)[chunk];
+        if (!entry) {
+            entry = std::make_shared<Chunk>();
+            entry->cells.fill(static_cast<Cell>(EMPTY));
+        }
+        return makeUnique(entry).cells.data() + localIndex(x, y);
+    }
+
+    // 配置数を更新し、占有ビットと疎格納のチャンク確保状態に反映
+    void adjustFilled(std::size_t chunk, int delta) {
+        Occupancy& counts = makeUnique(occupancy);
+        counts.filled[chunk] = static_cast<uint16_t>(counts.filled[chunk] + delta);
+        const uint64_t bit = uint64_t(1) << (chunk % 64);
+        if (counts.filled[chunk] > 0) {
+            counts.bits[chunk / 64] |= bit;
+        }
+        else {
+            counts.bits[chunk / 64] &= ~bit;
+            if (storage == Storage::Sparse) (*chunks)[chunk].reset(); // 全て空に戻ったチャンクは解放
+        }
+    }
+
+    int width = 0;
+    int height = 0;
+    int chunksX = 0;
+    int chunksY = 0;
+    Storage storage = Storage::Dense;
+
+    std::shared_ptr<CellBuffer> cells;     // 密格納のタイル
+    std::shared_ptr<ChunkTable> chunks;    // 疎格納のチャンク（空はnullptr）
+    std::shared_ptr<Occupancy> occupancy;  // チャンク単位の占有情報
+};
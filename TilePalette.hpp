@@ -3,6 +3,9 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <array>
+#include <cstdint>
+#include "UIHelper.hpp"
+#include "PaletteSnapshot.hpp"
 
 class TilePalette {
 private:
@@ -19,9 +22,94 @@ private:
     // VXeiꎞIɕj
     std::vector<std::array<sf::Color, 3>> colorPalettes; // @\ێ̂
 
+    // ύXmp̃o[Wԍieς邽тɒPj
+    uint64_t patternVersion = 0;
+    uint64_t colorIndexVersion = 0;
+
+    // `LbVȉԂL^Aωꍇ̂ݍ蒼j
+    sf::VertexArray cachedVertices;
+    bool cacheValid = false;
+    uint64_t cachedPatternVersion = 0;
+    uint64_t cachedColorIndexVersion = 0;
+    int cachedSelectedIndex = -1;
+    std::array<sf::Color, 16> cachedGlobalColors;
+
+    // `EóEۑp̕RȃXibvVbgigetSnapshotōXVj
+    PaletteSnapshot snapshot;
+    bool snapshotValid = false;
+
+    /**
+     * pbgŚi^CwiEgEZE"+"{^j̒_𐶐
+     * @param globalColors Z̐F̎QƐ
+     */
+    void buildVertices(const std::array<sf::Color, 16>& globalColors) {
+        cachedVertices.setPrimitiveType(sf::Quads);
+        cachedVertices.clear();
+
+        float cellSize = tileSize / 3.0f;
+
+        for (int i = 0; i < patterns.size(); ++i) {
+            int row = i / tilesPerRow;
+            int col = i % tilesPerRow;
+
+            float x = position.x + col * (tileSize + 5);
+            float y = position.y + row * (tileSize + 5);
+
+            // ^CwiƘg
+            appendQuad(cachedVertices, x, y, tileSize, tileSize, sf::Color(50, 50, 50));
+            appendOutline(cachedVertices, x, y, tileSize, tileSize, 2,
+                selectedIndex == i ? sf::Color::Yellow : sf::Color(100, 100, 100));
+
+            // p^[iO[oJ[gpj
+            const auto& pattern = patterns[i];
+            const auto& globalIndices = globalColorIndices[i];
+
+            if (pattern.size() >= 9) {
+                for (int idx = 0; idx < 9; ++idx) {
+                    int colorIndex = pattern[idx];
+
+                    // FCfbNX͈̔̓`FbNi0, 1, 2̂ݗLj
+                    if (colorIndex < 0 || colorIndex >= 3) continue;
+                    int globalColorIndex = globalIndices[colorIndex];
+                    if (globalColorIndex < 0 || globalColorIndex >= 16) continue;
+
+                    int cx = idx % 3;
+                    int cy = idx / 3;
+                    appendQuad(cachedVertices, x + cx * cellSize + 0.5f, y + cy * cellSize + 0.5f,
+                        cellSize - 1, cellSize - 1, globalColors[globalColorIndex]);
+                }
+            }
+        }
+
+        // "+" {^iVKǉpj
+        if (patterns.size() < maxTiles) {
+            int row = patterns.size() / tilesPerRow;
+            int col = patterns.size() % tilesPerRow;
+
+            float x = position.x + col * (tileSize + 5);
+            float y = position.y + row * (tileSize + 5);
+
+            appendQuad(cachedVertices, x, y, tileSize, tileSize, sf::Color(50, 50, 50));
+            appendOutline(cachedVertices, x, y, tileSize, tileSize, 1, sf::Color(100, 100, 100));
+
+            // "+" L
+            appendQuad(cachedVertices, x + tileSize / 2 - 2, y + tileSize * 0.2f, 4, tileSize * 0.6f,
+                sf::Color(200, 200, 200));
+            appendQuad(cachedVertices, x + tileSize * 0.2f, y + tileSize / 2 - 2, tileSize * 0.6f, 4,
+                sf::Color(200, 200, 200));
+        }
+
+        cachedPatternVersion = patternVersion;
+        cachedColorIndexVersion = colorIndexVersion;
+        cachedSelectedIndex = selectedIndex;
+        cachedGlobalColors = globalColors;
+        cacheValid = true;
+    }
+
 public:
     void setPosition(const sf::Vector2f& pos) {
         this->position = pos;
+        cacheValid = false;
     }
 
     void selectPattern(int index);
@@ -34,8 +122,57 @@ public:
     // V֐FO[oJ[CfbNXݒ
     void setGlobalColorIndices(int patternIndex, const std::array<int, 3>& colorIndices) {
         if (patternIndex >= 0 && patternIndex < globalColorIndices.size()) {
-            globalColorIndices[patternIndex] = colorIndices;
+            if (globalColorIndices[patternIndex] != colorIndices) {
+                globalColorIndices[patternIndex] = colorIndices;
+                ++colorIndexVersion;
+            }
+        }
+    }
+
+    /**
+     * p^[ẽo[Wԍ擾
+     * p^[̒ǉEҏWE폜̂тɑ
+     */
+    uint64_t getPatternVersion() const {
+        return patternVersion;
+    }
+
+    /**
+     * O[oJ[CfbNX̃o[Wԍ擾
+     * ꂩ̃p^[̎QƐFς邽тɑ
+     */
+    uint64_t getColorIndexVersion() const {
+        return colorIndexVersion;
+    }
+
+    /**
+     * Rpbg̃XibvVbg擾
+     * p^[EQƐFEO[oJ[̂Ao[Wς蒼
+     * ωȂΉO̓ê܂ܕԂiEmۂȂj
+     * @param globalColors F̉ɎgO[oJ[
+     * @param globalColorVersion O[oJ[̃o[Wԍ
+     */
+    const PaletteSnapshot& getSnapshot(const std::array<sf::Color, 16>& globalColors, uint64_t globalColorVersion) {
+        bool patternsChanged = !snapshotValid || snapshot.patternVersion != patternVersion;
+        bool indicesChanged = !snapshotValid || snapshot.colorIndexVersion != colorIndexVersion;
+        bool colorsChanged = !snapshotValid || snapshot.colorVersion != globalColorVersion;
+
+        if (patternsChanged) {
+            PaletteSnapshot::packCells(patterns, snapshot.cells);
+            snapshot.patternVersion = patternVersion;
+        }
+        if (indicesChanged) {
+            snapshot.colorIndices.assign(globalColorIndices.begin(), globalColorIndices.end());
+            snapshot.colorIndexVersion = colorIndexVersion;
         }
+        if (indicesChanged || colorsChanged) {
+            snapshot.globalColors = globalColors;
+            PaletteSnapshot::resolveColors(snapshot.colorIndices, snapshot.globalColors, snapshot.colors);
+            snapshot.colorVersion = globalColorVersion;
+        }
+
+        snapshotValid = true;
+        return snapshot;
     }
 
     // V֐FO[oJ[CfbNX擾
@@ -65,7 +202,10 @@ public:
             for (const auto& row : pattern)
                 for (int val : row)
                     flat.push_back(val);
-            patterns[index] = flat;
+            if (patterns[index] != flat) {
+                patterns[index] = flat;
+                ++patternVersion;
+            }
         }
     }
 
@@ -108,6 +248,8 @@ public:
 
         patterns.push_back(flatPattern);
         this->globalColorIndices.push_back(globalColorIndices);
+        ++patternVersion;
+        ++colorIndexVersion;
 
         // VXep̃_~[J[Zbgǉi݊̂߁j
         std::array<sf::Color, 3> dummyColors = {sf::Color::Red, sf::Color::Green, sf::Color::Blue};
@@ -171,77 +313,14 @@ public:
     }
 
     // V`֐FO[oJ[pbggp
+    // _̓p^[EFEIEʒuςꍇ̂ݍĐA1̕`Ăяoŕ\
     void drawWithGlobalColors(sf::RenderWindow& window, const std::array<sf::Color, 16>& globalColors) {
-        float cellSize = tileSize / 3.0f;
-
-        for (int i = 0; i < patterns.size(); ++i) {
-            int row = i / tilesPerRow;
-            int col = i % tilesPerRow;
-
-            float x = position.x + col * (tileSize + 5);
-            float y = position.y + row * (tileSize + 5);
-
-            // ^Cwi
-            sf::RectangleShape background(sf::Vector2f(tileSize, tileSize));
-            background.setPosition(x, y);
-            background.setFillColor(sf::Color(50, 50, 50));
-            background.setOutlineThickness(2);
-            background.setOutlineColor(selectedIndex == i ? sf::Color::Yellow : sf::Color(100, 100, 100));
-            window.draw(background);
-
-            // p^[`iO[oJ[gpj
-            const auto& pattern = patterns[i];
-            const auto& globalIndices = globalColorIndices[i];
-
-            if (pattern.size() >= 9) {
-                for (int cy = 0; cy < 3; ++cy) {
-                    for (int cx = 0; cx < 3; ++cx) {
-                        int idx = cy * 3 + cx;
-                        if (idx < pattern.size()) {
-                            int colorIndex = pattern[idx];
-
-                            // FCfbNX͈̔̓`FbNi0, 1, 2̂ݗLj
-                            if (colorIndex >= 0 && colorIndex < 3) {
-                                int globalColorIndex = globalIndices[colorIndex];
-                                if (globalColorIndex >= 0 && globalColorIndex < 16) {
-                                    sf::RectangleShape cell(sf::Vector2f(cellSize - 1, cellSize - 1));
-                                    cell.setPosition(x + cx * cellSize + 0.5f, y + cy * cellSize + 0.5f);
-                                    cell.setFillColor(globalColors[globalColorIndex]);
-                                    window.draw(cell);
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
-
-        // "+" {^iVKǉpj
-        if (patterns.size() < maxTiles) {
-            int row = patterns.size() / tilesPerRow;
-            int col = patterns.size() % tilesPerRow;
-
-            float x = position.x + col * (tileSize + 5);
-            float y = position.y + row * (tileSize + 5);
-
-            sf::RectangleShape addButton(sf::Vector2f(tileSize, tileSize));
-            addButton.setPosition(x, y);
-            addButton.setFillColor(sf::Color(50, 50, 50));
-            addButton.setOutlineThickness(1);
-            addButton.setOutlineColor(sf::Color(100, 100, 100));
-            window.draw(addButton);
-
-            // "+" L
-            sf::RectangleShape vLine(sf::Vector2f(4, tileSize * 0.6f));
-            vLine.setPosition(x + tileSize / 2 - 2, y + tileSize * 0.2f);
-            vLine.setFillColor(sf::Color(200, 200, 200));
-            window.draw(vLine);
-
-            sf::RectangleShape hLine(sf::Vector2f(tileSize * 0.6f, 4));
-            hLine.setPosition(x + tileSize * 0.2f, y + tileSize / 2 - 2);
-            hLine.setFillColor(sf::Color(200, 200, 200));
-            window.draw(hLine);
+        if (!cacheValid || cachedPatternVersion != patternVersion ||
+            cachedColorIndexVersion != colorIndexVersion ||
+            cachedSelectedIndex != selectedIndex || cachedGlobalColors != globalColors) {
+            buildVertices(globalColors);
         }
+        window.draw(cachedVertices);
     }
 
     // ̕`֐i݊ێj
@@ -355,7 +434,9 @@ public:
         for (int i = 0; i < patterns.size(); ++i) {
             globalColorIndices.push_back({0, 1, 2}); // ftHgFŏ3F
         }
-        
+
+        ++patternVersion;
+        ++colorIndexVersion;
         selectedIndex = -1;
     }
 
@@ -366,6 +447,8 @@ public:
         patterns.clear();
         colorPalettes.clear();
         globalColorIndices.clear();
+        ++patternVersion;
+        ++colorIndexVersion;
         selectedIndex = -1;
     }
 };
\ No newline at end of file
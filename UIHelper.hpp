@@ -3,6 +3,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <cmath>
+#include "TextCache.hpp"
 
 inline void drawText(
     sf::RenderWindow& window,
@@ -12,11 +14,89 @@ inline void drawText(
     sf::Vector2f position,
     sf::Color color = sf::Color::White
 ) {
-    sf::Text sfText;
-    sfText.setFont(font);
-    sfText.setString(text);
-    sfText.setCharacterSize(size);
-    sfText.setFillColor(color);
-    sfText.setPosition(position);
-    window.draw(sfText);
+    // CAEgς݂̃eLXgėpi񂪕ςꍇ̂ݐj
+    TextCache::shared().draw(window, font, text, size, position, color);
+}
+
+// ===== UIpl̒_LbVpwp[ =====
+// pl̐}`1̒_zɂ܂Ƃ߁AԂςꍇ̂ݍ蒼1ŕ`悷
+
+/**
+ * sȋ`ǉ
+ * _zsf::Triangles̏ꍇ2̎Op`AȊOQuadƂĒǉ
+ */
+inline void appendQuad(sf::VertexArray& vertices, float left, float top,
+    float width, float height, const sf::Color& color) {
+    sf::Vertex topLeft(sf::Vector2f(left, top), color);
+    sf::Vertex topRight(sf::Vector2f(left + width, top), color);
+    sf::Vertex bottomRight(sf::Vector2f(left + width, top + height), color);
+    sf::Vertex bottomLeft(sf::Vector2f(left, top + height), color);
+
+    if (vertices.getPrimitiveType() == sf::Triangles) {
+        vertices.append(topLeft);
+        vertices.append(topRight);
+        vertices.append(bottomRight);
+        vertices.append(topLeft);
+        vertices.append(bottomRight);
+        vertices.append(bottomLeft);
+    }
+    else {
+        vertices.append(topLeft);
+        vertices.append(topRight);
+        vertices.append(bottomRight);
+        vertices.append(bottomLeft);
+    }
+}
+
+/**
+ * `̊Oɘgǉisf::RectangleShape̗̐֊sƓ͈́AdȂȂj
+ * @param thickness g̑
+ */
+inline void appendOutline(sf::VertexArray& vertices, float left, float top,
+    float width, float height, float thickness, const sf::Color& color) {
+    appendQuad(vertices, left - thickness, top - thickness, width + thickness * 2, thickness, color);
+    appendQuad(vertices, left - thickness, top + height, width + thickness * 2, thickness, color);
+    appendQuad(vertices, left - thickness, top, thickness, height, color);
+    appendQuad(vertices, left + width, top, thickness, height, color);
+}
+
+/**
+ * hԂ~Op`Œǉi_zsf::Trianglesj
+ * @param pointCount ~̕isf::CircleShape̊l30j
+ */
+inline void appendCircle(sf::VertexArray& vertices, const sf::Vector2f& center, float radius,
+    const sf::Color& color, int pointCount = 30) {
+    const float step = 6.2831853f / pointCount;
+    for (int i = 0; i < pointCount; ++i) {
+        float a0 = i * step;
+        float a1 = (i + 1) * step;
+        vertices.append(sf::Vertex(center, color));
+        vertices.append(sf::Vertex(center + sf::Vector2f(radius * std::cos(a0), radius * std::sin(a0)), color));
+        vertices.append(sf::Vertex(center + sf::Vector2f(radius * std::cos(a1), radius * std::sin(a1)), color));
+    }
+}
+
+/**
+ * ~̊Oɗ֊sOp`Œǉi_zsf::Trianglesj
+ */
+inline void appendCircleOutline(sf::VertexArray& vertices, const sf::Vector2f& center, float radius,
+    float thickness, const sf::Color& color, int pointCount = 30) {
+    const float step = 6.2831853f / pointCount;
+    const float outer = radius + thickness;
+    for (int i = 0; i < pointCount; ++i) {
+        float a0 = i * step;
+        float a1 = (i + 1) * step;
+        sf::Vector2f d0(std::cos(a0), std::sin(a0));
+        sf::Vector2f d1(std::cos(a1), std::sin(a1));
+        sf::Vertex inner0(center + d0 * radius, color);
+        sf::Vertex inner1(center + d1 * radius, color);
+        sf::Vertex outer0(center + d0 * outer, color);
+        sf::Vertex outer1(center + d1 * outer, color);
+        vertices.append(inner0);
+        vertices.append(outer0);
+        vertices.append(outer1);
+        vertices.append(inner0);
+        vertices.append(outer1);
+        vertices.append(inner1);
+    }
 }
@@ -40,6 +40,12 @@ void UIManager::initializeButtons() {
 
     // r[
     buttons.emplace_back(std::make_unique<Button>("Reset View", sf::Vector2f(20, 770), sf::Vector2f(100, 30)));
+
+    // hԂc[ic[s̉E[j
+    buttons.emplace_back(std::make_unique<Button>("Fill", sf::Vector2f(320, 730), sf::Vector2f(40, 30)));
+
+    // Ic[iReset View̉Ej
+    buttons.emplace_back(std::make_unique<Button>("Select", sf::Vector2f(130, 770), sf::Vector2f(60, 30)));
 }
 
 void UIManager::initializeSliders(const sf::Font& font) {
@@ -87,30 +93,46 @@ Button& UIManager::getButton(ButtonIndex index) {
     return *buttons[static_cast<size_t>(index)];
 }
 
-void UIManager::updateButtons(const sf::Vector2i& mousePos) {
+bool UIManager::updateButtons(const sf::Vector2i& mousePos) {
+    bool changed = false;
     for (auto& button : buttons) {
-        button->update(mousePos);
+        changed = button->update(mousePos) || changed;
     }
+    return changed;
 }
 
 void UIManager::drawButtons(sf::RenderWindow& window, const sf::Font& font, ToolManager::ToolType activeToolType,
     int currentBrushSize, bool largeTilePaletteVisible, int rotationDegrees) {
+    // ANeBuEzo[ԂɂF̕ωo
+    bool changed = buttonStateColors.size() != buttons.size();
+    buttonStateColors.resize(buttons.size());
     for (size_t i = 0; i < buttons.size(); ++i) {
-        bool isActive = isButtonActive(i, activeToolType, currentBrushSize, largeTilePaletteVisible, rotationDegrees);
+        buttons[i]->setActiveState(
+            isButtonActive(i, activeToolType, currentBrushSize, largeTilePaletteVisible, rotationDegrees));
 
-        if (isActive) {
-            buttons[i]->setActiveState(true);
+        sf::Color stateColor = buttons[i]->getStateColor();
+        if (buttonStateColors[i] != stateColor) {
+            buttonStateColors[i] = stateColor;
+            changed = true;
         }
+    }
 
-        buttons[i]->draw(window, font);
+    // {^wi͂܂Ƃ߂1ŕ`
+    if (changed) {
+        buttonVertices.setPrimitiveType(sf::Quads);
+        buttonVertices.clear();
+        for (const auto& button : buttons) {
+            button->appendShape(buttonVertices);
+        }
+    }
+    window.draw(buttonVertices);
+
+    for (size_t i = 0; i < buttons.size(); ++i) {
+        buttons[i]->drawLabel(window, font);
 
         if (i == static_cast<size_t>(ButtonIndex::ROTATE_BUTTON)) {
             drawRotationIndicator(window, font, buttons[i]->getPosition(), rotationDegrees);
         }
-
-        if (isActive) {
-            buttons[i]->setActiveState(false);
-        }
     }
 }
 
@@ -156,6 +178,8 @@ bool UIManager::isButtonActive(size_t i, ToolManager::ToolType activeToolType, i
     if (i == static_cast<size_t>(ButtonIndex::TOOL_CIRCLE) && activeToolType == ToolManager::ToolType::CIRCLE) return true;
     if (i == static_cast<size_t>(ButtonIndex::TOOL_ELLIPSE) && activeToolType == ToolManager::ToolType::ELLIPSE) return true;
     if (i == static_cast<size_t>(ButtonIndex::TOOL_LARGE_TILE) && activeToolType == ToolManager::ToolType::LARGE_TILE) return true;
+    if (i == static_cast<size_t>(ButtonIndex::TOOL_FILL) && activeToolType == ToolManager::ToolType::FILL) return true;
+    if (i == static_cast<size_t>(ButtonIndex::TOOL_SELECT) && activeToolType == ToolManager::ToolType::SELECT) return true;
 
     // uVTCY{^̃ANeBu
     if (i == static_cast<size_t>(ButtonIndex::BRUSH_SMALL) && currentBrushSize == 1) return true;
@@ -213,10 +237,10 @@ void UIManager::drawRotationIndicator(sf::RenderWindow& window, const sf::Font&
     const sf::Vector2f& buttonPos, int rotationDegrees) {
     if (rotationDegrees == 0) return;
 
-    sf::Text rotationText(std::to_string(rotationDegrees) + "", font, 10);
-    rotationText.setPosition(buttonPos.x + 75, buttonPos.y + 20);
-    rotationText.setFillColor(sf::Color::Yellow);
-    window.draw(rotationText);
+    // px0/90/180/2704ʂȂ̂ŒfЂƂɃLbV
+    std::string degreesText = std::to_string(rotationDegrees);
+    TextCache::shared().drawFragments(window, font, 10, sf::Vector2f(buttonPos.x + 75, buttonPos.y + 20),
+        sf::Color::Yellow, { degreesText, "" });
 
     drawRotationArrow(window, buttonPos, rotationDegrees);
 }
@@ -21,7 +21,8 @@ enum class ButtonIndex {
 	BRUSH_SMALL = 7, BRUSH_MEDIUM = 8, BRUSH_LARGE = 9,
 	TOOL_BRUSH = 10, TOOL_ERASER = 11, TOOL_LINE = 12,
 	TOOL_CIRCLE = 13, TOOL_ELLIPSE = 14, TOOL_LARGE_TILE = 15,
-	LARGE_TILE_PALETTE_TOGGLE = 16, ROTATE_BUTTON = 17, RESET_VIEW = 18
+	LARGE_TILE_PALETTE_TOGGLE = 16, ROTATE_BUTTON = 17, RESET_VIEW = 18,
+	TOOL_FILL = 19, TOOL_SELECT = 20
 };
 
 /**
@@ -34,13 +35,17 @@ private:
 	std::vector<sf::CircleShape> knobs;
 	std::vector<sf::Text> labels;
 
+	// {^wi̕`LbViꂩ̃{^̐Fςꍇ̂ݍĐj
+	sf::VertexArray buttonVertices;
+	std::vector<sf::Color> buttonStateColors;
+
 public:
 	UIManager(const sf::Font& font);
 
 	// {^֘A
 	void initializeButtons();
 	Button& getButton(ButtonIndex index);
-	void updateButtons(const sf::Vector2i& mousePos);
+	bool updateButtons(const sf::Vector2i& mousePos); // zo[Ԃωꍇtrue
 	void drawButtons(sf::RenderWindow& window, const sf::Font& font, ToolManager::ToolType activeToolType,
 		int currentBrushSize, bool largeTilePaletteVisible = false, int rotationDegrees = 0);
 